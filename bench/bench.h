@@ -0,0 +1,483 @@
+#pragma once
+/*
+ * Minimal benchmark harness in the style of Google Benchmark
+ * Register:   CP_BENCHMARK(fn)->arg(1 << 10)->range(1 << 10, 1 << 20, 32)->args({n, kind})
+ * Body:       void fn(cp::bench::State &state) { setup; for (auto _ : state) { timed work } }
+ * Reports:    ns per item (throughput) and p50 / p99 latency over batches of iterations
+ * Flags:      --filter=<substring> --min_time=<seconds> --repetitions=<k> --json=<path>
+ */
+
+// Every benchmark is run once with a growing iteration count until a run
+// takes a tenth of --min_time, then `repetitions` times with the iteration
+// count that fills min_time. Each timed loop is split into about 64 batches
+// (a power of two iterations each); the per-item time of every batch is a
+// latency sample, and p50 / p99 are taken over all samples of all
+// repetitions. Throughput is the total time over the total item count.
+//
+// A body that processes several items per iteration (a batch of queries, all
+// edges of a graph) calls state.set_items_per_iteration(k) so that results
+// are always per item and comparable across structures.
+//
+// --json writes every result with the compiler and flags, so two runs (e.g.
+// two releases) can be compared with bench/compare.py.
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#ifndef CP_BENCH_FLAGS
+#define CP_BENCH_FLAGS ""
+#endif
+
+namespace cp::bench
+{
+    /// @brief Forces `value` to be materialized, so the computation producing it is not optimized away.
+    template <typename T>
+    inline void do_not_optimize(const T &value)
+    {
+        if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(void *))
+            asm volatile("" : : "r,m"(value) : "memory");
+        else
+            asm volatile("" : : "m"(value) : "memory");
+    }
+
+    template <typename T>
+    inline void do_not_optimize(T &value)
+    {
+        if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(void *))
+            asm volatile("" : "+r"(value) : : "memory");
+        else
+            asm volatile("" : "+m"(value) : : "memory");
+    }
+
+    /// @brief Forces all pending writes to memory to be treated as observable.
+    inline void clobber_memory() { asm volatile("" : : : "memory"); }
+
+    /**
+     * @brief The per-run handle passed to a benchmark body; iterating it runs the timed loop.
+     */
+    class State
+    {
+    private:
+        using clock = std::chrono::steady_clock;
+
+        std::vector<long long> m_args;
+        size_t m_iterations;
+        size_t m_batch;
+        size_t m_remaining = 0;
+        size_t m_items_per_iteration = 1;
+        clock::time_point m_start, m_lap;
+        double m_elapsed_ns = 0;
+        std::vector<double> m_samples; // ns per iteration of each batch
+        bool m_skipped = false;
+        std::string m_error;
+
+        void lap(clock::time_point now)
+        {
+            m_samples.push_back(std::chrono::duration<double, std::nano>(now - m_lap).count() / m_batch);
+            m_lap = now;
+        }
+
+        bool keep_running()
+        {
+            if (m_remaining == 0)
+            {
+                auto now = clock::now();
+                m_elapsed_ns = std::chrono::duration<double, std::nano>(now - m_start).count();
+                lap(now);
+                return false;
+            }
+            if ((m_remaining & (m_batch - 1)) == 0 && m_remaining != m_iterations)
+            {
+                lap(clock::now());
+            }
+            --m_remaining;
+            return true;
+        }
+
+        friend class Runner;
+
+    public:
+        struct Sentinel
+        {
+        };
+
+        /// @brief What `auto _` binds to; an empty class so the unused loop variable draws no warning.
+        struct Value
+        {
+            Value() {}
+            ~Value() {}
+        };
+
+        class Iterator
+        {
+            State *m_state;
+
+        public:
+            explicit Iterator(State *state) : m_state(state) {}
+            bool operator!=(Sentinel) const { return m_state->keep_running(); }
+            void operator++() {}
+            Value operator*() const { return {}; }
+        };
+
+        /**
+         * @param args The argument list of this run.
+         * @param iterations The number of timed iterations, a multiple of batch.
+         * @param batch Iterations per latency sample, a power of two.
+         */
+        State(std::vector<long long> args, size_t iterations, size_t batch)
+            : m_args(std::move(args)), m_iterations(iterations), m_batch(batch) {}
+
+        /// @brief Starts the clock. Everything before the range-for is untimed setup.
+        Iterator begin()
+        {
+            m_remaining = m_iterations;
+            m_samples.clear();
+            m_start = m_lap = clock::now();
+            return Iterator(this);
+        }
+
+        Sentinel end() const { return {}; }
+
+        /// @brief Returns the i-th registered argument of this run.
+        long long arg(size_t i) const { return i < m_args.size() ? m_args[i] : 0; }
+
+        const std::vector<long long> &args() const { return m_args; }
+
+        size_t iterations() const { return m_iterations; }
+
+        /// @brief Declares how many items one iteration processes; results are reported per item.
+        void set_items_per_iteration(size_t items) { m_items_per_iteration = std::max<size_t>(items, 1); }
+
+        /// @brief Skips this run (e.g. an input size the structure cannot handle) with a reason.
+        void skip(std::string reason)
+        {
+            m_skipped = true;
+            m_error = std::move(reason);
+            m_remaining = 0;
+        }
+    };
+
+    /**
+     * @brief A registered benchmark: a body and the argument lists to run it with.
+     */
+    class Benchmark
+    {
+    private:
+        std::string m_name;
+        std::function<void(State &)> m_fn;
+        std::vector<std::vector<long long>> m_args;
+
+        friend class Runner;
+
+    public:
+        Benchmark(std::string name, std::function<void(State &)> fn) : m_name(std::move(name)), m_fn(std::move(fn)) {}
+
+        /// @brief Adds a run with a single argument.
+        Benchmark *arg(long long a)
+        {
+            m_args.push_back({a});
+            return this;
+        }
+
+        /// @brief Adds a run with several arguments.
+        Benchmark *args(std::vector<long long> a)
+        {
+            m_args.push_back(std::move(a));
+            return this;
+        }
+
+        /// @brief Adds runs for lo, lo * mult, ... up to and including hi.
+        Benchmark *range(long long lo, long long hi, long long mult = 8)
+        {
+            for (long long a = lo; a < hi; a *= std::max(2LL, mult))
+                m_args.push_back({a});
+            m_args.push_back({hi});
+            return this;
+        }
+
+        /// @brief Adds one run per element of the cross product of the given argument sets.
+        Benchmark *cross(const std::vector<std::vector<long long>> &sets)
+        {
+            std::vector<std::vector<long long>> product = {{}};
+            for (const auto &set : sets)
+            {
+                std::vector<std::vector<long long>> next;
+                for (const auto &prefix : product)
+                    for (long long a : set)
+                    {
+                        next.push_back(prefix);
+                        next.back().push_back(a);
+                    }
+                product.swap(next);
+            }
+            m_args.insert(m_args.end(), product.begin(), product.end());
+            return this;
+        }
+    };
+
+    inline std::vector<std::unique_ptr<Benchmark>> &registry()
+    {
+        static std::vector<std::unique_ptr<Benchmark>> benchmarks;
+        return benchmarks;
+    }
+
+    inline Benchmark *register_benchmark(std::string name, std::function<void(State &)> fn)
+    {
+        registry().push_back(std::make_unique<Benchmark>(std::move(name), std::move(fn)));
+        return registry().back().get();
+    }
+
+    /**
+     * @brief The measurements of one run of one benchmark.
+     */
+    struct Result
+    {
+        std::string name;
+        size_t iterations = 0;
+        size_t items_per_iteration = 1;
+        double ns_per_item = 0, items_per_second = 0;
+        double p50_ns = 0, p99_ns = 0, min_ns = 0;
+        bool skipped = false;
+        std::string error;
+    };
+
+    /**
+     * @brief Runs the registry according to the command line and reports the results.
+     */
+    class Runner
+    {
+    private:
+        std::string m_filter;
+        double m_min_time = 0.5;
+        int m_repetitions = 3;
+        std::string m_json;
+        std::vector<Result> m_results;
+
+        static constexpr size_t SAMPLES = 64;
+
+        static std::string run_name(const Benchmark &b, const std::vector<long long> &args)
+        {
+            std::string name = b.m_name;
+            for (long long a : args)
+                name += "/" + std::to_string(a);
+            return name;
+        }
+
+        static size_t batch_for(size_t iterations)
+        {
+            size_t batch = 1;
+            while (batch * 2 * SAMPLES <= iterations)
+                batch *= 2;
+            return batch;
+        }
+
+        static double percentile(std::vector<double> &v, double q)
+        {
+            size_t k = std::min(v.size() - 1, static_cast<size_t>(q * (v.size() - 1) + 0.5));
+            std::nth_element(v.begin(), v.begin() + k, v.end());
+            return v[k];
+        }
+
+        Result run_one(const Benchmark &b, const std::vector<long long> &args) const
+        {
+            Result r;
+            r.name = run_name(b, args);
+
+            // Calibration: grow the iteration count until one run is long enough to extrapolate.
+            size_t iterations = 1;
+            double per_iteration = 0;
+            while (true)
+            {
+                State s(args, iterations, std::bit_ceil(iterations)); // one sample: no per-batch bookkeeping
+                b.m_fn(s);
+                if (s.m_skipped)
+                {
+                    r.skipped = true, r.error = s.m_error;
+                    return r;
+                }
+                per_iteration = s.m_elapsed_ns / iterations;
+                if (s.m_elapsed_ns >= m_min_time * 1e8 || iterations >= (size_t(1) << 40))
+                    break;
+                double grow = s.m_elapsed_ns > 0 ? m_min_time * 1e8 / s.m_elapsed_ns * 1.4 : 10;
+                iterations = static_cast<size_t>(iterations * std::clamp(grow, 2.0, 10.0));
+            }
+
+            iterations = std::max<size_t>(1, static_cast<size_t>(m_min_time * 1e9 / std::max(per_iteration, 1e-3)));
+            size_t batch = batch_for(iterations);
+            iterations = (iterations + batch - 1) / batch * batch;
+
+            double total_ns = 0;
+            std::vector<double> samples;
+            for (int rep = 0; rep < m_repetitions; ++rep)
+            {
+                State s(args, iterations, batch);
+                b.m_fn(s);
+                total_ns += s.m_elapsed_ns;
+                r.items_per_iteration = s.m_items_per_iteration;
+                for (double x : s.m_samples)
+                    samples.push_back(x / s.m_items_per_iteration);
+            }
+
+            r.iterations = iterations;
+            double items = static_cast<double>(iterations) * m_repetitions * r.items_per_iteration;
+            r.ns_per_item = total_ns / items;
+            r.items_per_second = total_ns > 0 ? items / total_ns * 1e9 : 0;
+            r.min_ns = *std::min_element(samples.begin(), samples.end());
+            r.p50_ns = percentile(samples, 0.50);
+            r.p99_ns = percentile(samples, 0.99);
+            return r;
+        }
+
+        static void print_header()
+        {
+            std::printf("%-48s %14s %12s %12s %12s %14s\n", "Benchmark", "Iterations", "ns/item", "p50 ns", "p99 ns", "items/s");
+            std::printf("%s\n", std::string(117, '-').c_str());
+        }
+
+        static void print(const Result &r)
+        {
+            if (r.skipped)
+            {
+                std::printf("%-48s SKIPPED: %s\n", r.name.c_str(), r.error.c_str());
+            }
+            else
+            {
+                std::printf("%-48s %14zu %12.3f %12.3f %12.3f %14.4g\n", r.name.c_str(), r.iterations, r.ns_per_item, r.p50_ns,
+                            r.p99_ns, r.items_per_second);
+            }
+            std::fflush(stdout);
+        }
+
+        static std::string escape(std::string_view s)
+        {
+            std::string out;
+            for (char c : s)
+            {
+                if (c == '"' || c == '\\')
+                    out += '\\';
+                out += c;
+            }
+            return out;
+        }
+
+        bool write_json() const
+        {
+            std::FILE *f = std::fopen(m_json.c_str(), "w");
+            if (!f)
+            {
+                std::fprintf(stderr, "cannot open %s for writing\n", m_json.c_str());
+                return false;
+            }
+            char date[32];
+            std::time_t now = std::time(nullptr);
+            std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+            std::fprintf(f, "{\n  \"context\": {\n");
+            std::fprintf(f, "    \"date\": \"%s\",\n", date);
+            std::fprintf(f, "    \"compiler\": \"%s\",\n", escape(__VERSION__).c_str());
+            std::fprintf(f, "    \"flags\": \"%s\",\n", escape(CP_BENCH_FLAGS).c_str());
+            std::fprintf(f, "    \"min_time\": %g,\n    \"repetitions\": %d\n  },\n", m_min_time, m_repetitions);
+            std::fprintf(f, "  \"benchmarks\": [");
+            for (size_t i = 0; i < m_results.size(); ++i)
+            {
+                const Result &r = m_results[i];
+                std::fprintf(f, "%s\n    {\"name\": \"%s\"", i ? "," : "", escape(r.name).c_str());
+                if (r.skipped)
+                {
+                    std::fprintf(f, ", \"skipped\": true, \"error\": \"%s\"}", escape(r.error).c_str());
+                    continue;
+                }
+                std::fprintf(f,
+                             ", \"iterations\": %zu, \"items_per_iteration\": %zu, \"ns_per_item\": %.4f, "
+                             "\"items_per_second\": %.6g, \"min_ns\": %.4f, \"p50_ns\": %.4f, \"p99_ns\": %.4f}",
+                             r.iterations, r.items_per_iteration, r.ns_per_item, r.items_per_second, r.min_ns, r.p50_ns,
+                             r.p99_ns);
+            }
+            std::fprintf(f, "\n  ]\n}\n");
+            std::fclose(f);
+            return true;
+        }
+
+        static bool flag(std::string_view arg, std::string_view name, std::string_view &value)
+        {
+            if (arg.substr(0, name.size()) != name)
+                return false;
+            value = arg.substr(name.size());
+            return true;
+        }
+
+    public:
+        /// @brief Parses the flags. Returns false (after printing usage) on an unknown one.
+        bool parse(int argc, char **argv)
+        {
+            for (int i = 1; i < argc; ++i)
+            {
+                std::string_view a = argv[i], v;
+                if (flag(a, "--filter=", v))
+                    m_filter = v;
+                else if (flag(a, "--min_time=", v))
+                    m_min_time = std::max(1e-3, std::atof(std::string(v).c_str()));
+                else if (flag(a, "--repetitions=", v))
+                    m_repetitions = std::max(1, std::atoi(std::string(v).c_str()));
+                else if (flag(a, "--json=", v))
+                    m_json = v;
+                else
+                {
+                    std::fprintf(stderr, "usage: %s [--filter=<substring>] [--min_time=<seconds>] [--repetitions=<k>] [--json=<path>]\n",
+                                 argv[0]);
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /// @brief Runs every registered benchmark whose run name contains the filter.
+        int run()
+        {
+            print_header();
+            for (const auto &b : registry())
+            {
+                std::vector<std::vector<long long>> arg_sets = b->m_args;
+                if (arg_sets.empty())
+                    arg_sets.push_back({});
+                for (const auto &args : arg_sets)
+                {
+                    if (run_name(*b, args).find(m_filter) == std::string::npos)
+                        continue;
+                    m_results.push_back(run_one(*b, args));
+                    print(m_results.back());
+                }
+            }
+            if (!m_json.empty() && !write_json())
+                return 1;
+            return 0;
+        }
+    };
+
+    /// @brief Entry point: parses the flags and runs the registry.
+    inline int main(int argc, char **argv)
+    {
+        Runner runner;
+        if (!runner.parse(argc, argv))
+            return 2;
+        return runner.run();
+    }
+}
+
+#define CP_BENCH_CONCAT_IMPL(a, b) a##b
+#define CP_BENCH_CONCAT(a, b) CP_BENCH_CONCAT_IMPL(a, b)
+
+/// @brief Registers `fn` under its own name; chain ->arg() / ->range() / ->args() / ->cross() for the runs.
+#define CP_BENCHMARK(fn) \
+    [[maybe_unused]] static ::cp::bench::Benchmark *CP_BENCH_CONCAT(cp_bench_registration_, __COUNTER__) = ::cp::bench::register_benchmark(#fn, fn)
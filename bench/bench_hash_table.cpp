@@ -0,0 +1,90 @@
+// Hash maps under random keys and anti-hash keys: HashTable (gp_hash_table
+// with chash), cp::FlatHashMap, std::unordered_map, and gp_hash_table with
+// its default std::hash as the unprotected baseline. Unprotected maps on
+// anti-hash keys degrade quadratically, so they only run at small sizes.
+
+#include "bench.h"
+#include "generators.h"
+
+#include <unordered_map>
+
+#include "../include/data_structures/flat_hash_map.h"
+#include "../include/data_structures/hash_table.h"
+
+using namespace cp::bench;
+
+enum Keys
+{
+    RANDOM,
+    SHIFTED,        // multiples of 2^20: one slot of a power-of-two table with identity hash
+    BUCKET_COLLIDE, // multiples of std::unordered_map's final bucket count
+};
+
+using PlainGpHashTable = __gnu_pbds::gp_hash_table<long long, int>;
+using StdUnorderedMap = std::unordered_map<long long, int>;
+
+static std::vector<long long> make_keys(int kind, size_t n)
+{
+    switch (kind)
+    {
+    case SHIFTED:
+        return gen::shifted_keys(n);
+    case BUCKET_COLLIDE:
+        return gen::bucket_collision_keys<StdUnorderedMap>(n);
+    default:
+        return gen::random_ints<long long>(n, 0, 1LL << 62);
+    }
+}
+
+template <typename Map>
+static void BM_HashInsert(State &state)
+{
+    size_t n = state.arg(0);
+    auto keys = make_keys(state.arg(1), n);
+    state.set_items_per_iteration(n);
+    for (auto _ : state)
+    {
+        Map map;
+        for (long long k : keys)
+            map[k]++;
+        do_not_optimize(map);
+    }
+}
+
+template <typename Map>
+static void BM_HashLookup(State &state)
+{
+    size_t n = state.arg(0);
+    auto keys = make_keys(state.arg(1), n);
+    Map map;
+    for (long long k : keys)
+        map[k] = 1;
+    // Half hits in random order, half misses.
+    auto probes = keys;
+    std::shuffle(probes.begin(), probes.end(), std::mt19937_64(gen::DEFAULT_SEED));
+    for (size_t i = 0; i < probes.size(); i += 2)
+        probes[i] += 1;
+    state.set_items_per_iteration(n);
+    for (auto _ : state)
+    {
+        size_t hits = 0;
+        for (long long k : probes)
+            hits += map.find(k) != map.end();
+        do_not_optimize(hits);
+    }
+}
+
+// arg 0: number of keys, arg 1: key set (0 random, 1 shifted, 2 bucket-colliding)
+#define HASH_BENCHMARKS(Map)                                                                   \
+    CP_BENCHMARK(BM_HashInsert<Map>)->cross({{1 << 10, 1 << 16, 1 << 20}, {RANDOM, SHIFTED, BUCKET_COLLIDE}}); \
+    CP_BENCHMARK(BM_HashLookup<Map>)->cross({{1 << 10, 1 << 16, 1 << 20}, {RANDOM, SHIFTED, BUCKET_COLLIDE}})
+
+using ChashTable = HashTable<long long, int>;
+using ChashFlatMap = cp::FlatHashMap<long long, int>;
+HASH_BENCHMARKS(ChashTable);
+HASH_BENCHMARKS(ChashFlatMap);
+
+CP_BENCHMARK(BM_HashInsert<StdUnorderedMap>)->cross({{1 << 10, 1 << 16, 1 << 20}, {RANDOM, SHIFTED}})->cross({{1 << 10, 1 << 14}, {BUCKET_COLLIDE}});
+CP_BENCHMARK(BM_HashLookup<StdUnorderedMap>)->cross({{1 << 10, 1 << 16, 1 << 20}, {RANDOM, SHIFTED}})->cross({{1 << 10, 1 << 14}, {BUCKET_COLLIDE}});
+CP_BENCHMARK(BM_HashInsert<PlainGpHashTable>)->cross({{1 << 10, 1 << 16, 1 << 20}, {RANDOM, BUCKET_COLLIDE}})->cross({{1 << 10, 1 << 14}, {SHIFTED}});
+CP_BENCHMARK(BM_HashLookup<PlainGpHashTable>)->cross({{1 << 10, 1 << 16, 1 << 20}, {RANDOM, BUCKET_COLLIDE}})->cross({{1 << 10, 1 << 14}, {SHIFTED}});
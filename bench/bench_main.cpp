@@ -0,0 +1,5 @@
+// Entry point of cp_bench; every bench_*.cpp registers its benchmarks with CP_BENCHMARK.
+
+#include "bench.h"
+
+int main(int argc, char **argv) { return cp::bench::main(argc, argv); }
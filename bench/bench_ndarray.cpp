@@ -0,0 +1,128 @@
+// NDArray element access: checked operator() against FixedNDArray, raw
+// pointer walks, row- versus column-order traversal, and the whole-array
+// expression templates, all over the same n x n matrix.
+
+#include "bench.h"
+#include "generators.h"
+
+#include "../include/data_structures/ndarray.h"
+
+using namespace cp::bench;
+
+static NDArray<int> random_matrix(size_t n)
+{
+    NDArray<int> a({n, n}, ndarray_uninitialized);
+    auto values = gen::random_ints<int>(n * n, -1000, 1000);
+    std::copy(values.begin(), values.end(), a.data());
+    return a;
+}
+
+static void BM_NDArrayRowMajor(State &state)
+{
+    size_t n = state.arg(0);
+    NDArray<int> a = random_matrix(n);
+    state.set_items_per_iteration(n * n);
+    for (auto _ : state)
+    {
+        long long sum = 0;
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j)
+                sum += a(i, j);
+        do_not_optimize(sum);
+    }
+}
+
+static void BM_NDArrayColumnMajor(State &state)
+{
+    size_t n = state.arg(0);
+    NDArray<int> a = random_matrix(n);
+    state.set_items_per_iteration(n * n);
+    for (auto _ : state)
+    {
+        long long sum = 0;
+        for (size_t j = 0; j < n; ++j)
+            for (size_t i = 0; i < n; ++i)
+                sum += a(i, j);
+        do_not_optimize(sum);
+    }
+}
+
+static void BM_FixedNDArrayRowMajor(State &state)
+{
+    size_t n = state.arg(0);
+    NDArray<int> src = random_matrix(n);
+    FixedNDArray<int, 2> a({n, n}, ndarray_uninitialized);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+            a(i, j) = src(i, j);
+    state.set_items_per_iteration(n * n);
+    for (auto _ : state)
+    {
+        long long sum = 0;
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j)
+                sum += a(i, j);
+        do_not_optimize(sum);
+    }
+}
+
+static void BM_NDArrayRawPointer(State &state)
+{
+    size_t n = state.arg(0);
+    NDArray<int> a = random_matrix(n);
+    state.set_items_per_iteration(n * n);
+    for (auto _ : state)
+    {
+        long long sum = 0;
+        const int *p = a.data();
+        for (size_t k = 0; k < n * n; ++k)
+            sum += p[k];
+        do_not_optimize(sum);
+    }
+}
+
+static void BM_NDArrayViewForEach(State &state)
+{
+    size_t n = state.arg(0);
+    NDArray<int> a = random_matrix(n);
+    state.set_items_per_iteration(n * n);
+    for (auto _ : state)
+    {
+        long long sum = 0;
+        a.view().for_each([&sum](const int &x)
+                          { sum += x; });
+        do_not_optimize(sum);
+    }
+}
+
+static void BM_NDArrayExprAxpy(State &state)
+{
+    size_t n = state.arg(0);
+    NDArray<int> a = random_matrix(n), b = random_matrix(n), c({n, n});
+    state.set_items_per_iteration(n * n);
+    for (auto _ : state)
+    {
+        c = a * 3 + b;
+        clobber_memory();
+    }
+}
+
+static void BM_NDArraySumAxis(State &state)
+{
+    size_t n = state.arg(0);
+    NDArray<int> a = random_matrix(n);
+    state.set_items_per_iteration(n * n);
+    for (auto _ : state)
+    {
+        NDArray<int> s = a.sum(state.arg(1));
+        do_not_optimize(s);
+    }
+}
+
+CP_BENCHMARK(BM_NDArrayRowMajor)->range(64, 2048, 4);
+CP_BENCHMARK(BM_NDArrayColumnMajor)->range(64, 2048, 4);
+CP_BENCHMARK(BM_FixedNDArrayRowMajor)->range(64, 2048, 4);
+CP_BENCHMARK(BM_NDArrayRawPointer)->range(64, 2048, 4);
+CP_BENCHMARK(BM_NDArrayViewForEach)->range(64, 2048, 4);
+CP_BENCHMARK(BM_NDArrayExprAxpy)->range(64, 2048, 4);
+CP_BENCHMARK(BM_NDArraySumAxis)->cross({{256, 2048}, {0, 1}});
@@ -0,0 +1,127 @@
+// Range-query structures on the same inputs: cp::FenwickTree (sums),
+// the recursive lazy SegmentTree (RMQ) and the iterative cp::SegTree over a
+// monoid (min), so the cost of generality is visible next to each other.
+
+#include "bench.h"
+#include "generators.h"
+
+#include "../include/data_structures/fenwick_tree.h"
+#include "../include/data_structures/iterative_segment_tree.h"
+#include "../include/data_structures/segment_tree.h"
+
+using namespace cp::bench;
+
+constexpr size_t QUERIES = 1 << 12;
+
+static void BM_FenwickAdd(State &state)
+{
+    int n = state.arg(0);
+    cp::FenwickTree<long long> ft(gen::random_ints<long long>(n, 0, 1000));
+    auto idx = gen::random_indices(QUERIES, n);
+    state.set_items_per_iteration(QUERIES);
+    for (auto _ : state)
+    {
+        for (int i : idx)
+            ft.add(i + 1, 1);
+        clobber_memory();
+    }
+}
+
+static void BM_FenwickQuery(State &state)
+{
+    int n = state.arg(0);
+    cp::FenwickTree<long long> ft(gen::random_ints<long long>(n, 0, 1000));
+    auto idx = gen::random_indices(QUERIES, n);
+    state.set_items_per_iteration(QUERIES);
+    for (auto _ : state)
+    {
+        long long sum = 0;
+        for (int i : idx)
+            sum += ft.query(i + 1);
+        do_not_optimize(sum);
+    }
+}
+
+static void BM_FenwickFindKth(State &state)
+{
+    int n = state.arg(0);
+    cp::FenwickTree<long long> ft(gen::random_ints<long long>(n, 0, 1000));
+    auto ks = gen::random_ints<long long>(QUERIES, 1, ft.query(n));
+    state.set_items_per_iteration(QUERIES);
+    for (auto _ : state)
+    {
+        long long sum = 0;
+        for (long long k : ks)
+            sum += ft.find_kth(k);
+        do_not_optimize(sum);
+    }
+}
+
+static void BM_SegmentTreeRMQ(State &state)
+{
+    int n = state.arg(0);
+    auto values = gen::random_ints<int>(n, 0, 1 << 30);
+    SegmentTree st(values);
+    auto lo = gen::random_indices(QUERIES, n, 1), hi = gen::random_indices(QUERIES, n, 2);
+    state.set_items_per_iteration(QUERIES);
+    for (auto _ : state)
+    {
+        long long sum = 0;
+        for (size_t q = 0; q < QUERIES; ++q)
+            sum += st.RMQ(std::min(lo[q], hi[q]), std::max(lo[q], hi[q]));
+        do_not_optimize(sum);
+    }
+}
+
+static void BM_SegmentTreeUpdate(State &state)
+{
+    int n = state.arg(0);
+    SegmentTree st(gen::random_ints<int>(n, 0, 1 << 30));
+    auto idx = gen::random_indices(QUERIES, n);
+    auto val = gen::random_ints<int>(QUERIES, 0, 1 << 30);
+    state.set_items_per_iteration(QUERIES);
+    for (auto _ : state)
+    {
+        for (size_t q = 0; q < QUERIES; ++q)
+            st.update(idx[q], idx[q], val[q]);
+        clobber_memory();
+    }
+}
+
+static void BM_SegTreeMinProd(State &state)
+{
+    int n = state.arg(0);
+    cp::SegTree<cp::monoid::Min<int>> st(gen::random_ints<int>(n, 0, 1 << 30));
+    auto lo = gen::random_indices(QUERIES, n, 1), hi = gen::random_indices(QUERIES, n, 2);
+    state.set_items_per_iteration(QUERIES);
+    for (auto _ : state)
+    {
+        long long sum = 0;
+        for (size_t q = 0; q < QUERIES; ++q)
+            sum += st.prod(std::min(lo[q], hi[q]), std::max(lo[q], hi[q]) + 1);
+        do_not_optimize(sum);
+    }
+}
+
+static void BM_SegTreeMinSet(State &state)
+{
+    int n = state.arg(0);
+    cp::SegTree<cp::monoid::Min<int>> st(gen::random_ints<int>(n, 0, 1 << 30));
+    auto idx = gen::random_indices(QUERIES, n);
+    auto val = gen::random_ints<int>(QUERIES, 0, 1 << 30);
+    state.set_items_per_iteration(QUERIES);
+    for (auto _ : state)
+    {
+        for (size_t q = 0; q < QUERIES; ++q)
+            st.set(idx[q], val[q]);
+        clobber_memory();
+    }
+}
+
+CP_BENCHMARK(BM_FenwickAdd)->range(1 << 10, 1 << 22, 16);
+CP_BENCHMARK(BM_FenwickQuery)->range(1 << 10, 1 << 22, 16);
+CP_BENCHMARK(BM_FenwickFindKth)->range(1 << 10, 1 << 22, 16);
+CP_BENCHMARK(BM_SegmentTreeRMQ)->range(1 << 10, 1 << 22, 16);
+CP_BENCHMARK(BM_SegmentTreeUpdate)->range(1 << 10, 1 << 22, 16);
+CP_BENCHMARK(BM_SegTreeMinProd)->range(1 << 10, 1 << 22, 16);
+CP_BENCHMARK(BM_SegTreeMinSet)->range(1 << 10, 1 << 22, 16);
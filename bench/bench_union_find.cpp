@@ -0,0 +1,57 @@
+// Union-find variants on random and adversarial graphs. One iteration builds
+// a fresh structure, applies every union and then answers n connectivity
+// queries, so the cost of deep trees before compression is included.
+
+#include "bench.h"
+#include "generators.h"
+
+#include "../include/data_structures/union_find.h"
+
+using namespace cp::bench;
+
+enum Graph
+{
+    RANDOM,
+    PATH,
+    STAR,
+    BINOMIAL
+};
+
+static std::vector<gen::Edge> make_graph(int kind, int n)
+{
+    switch (kind)
+    {
+    case PATH:
+        return gen::path_edges(n);
+    case STAR:
+        return gen::star_edges(n);
+    case BINOMIAL:
+        return gen::binomial_edges(n);
+    default:
+        return gen::random_edges(n, n);
+    }
+}
+
+template <typename UF>
+static void BM_UnionFind(State &state)
+{
+    int n = state.arg(0);
+    auto edges = make_graph(state.arg(1), n);
+    auto queries = gen::random_edges(n, n, 7);
+    state.set_items_per_iteration(edges.size() + queries.size());
+    for (auto _ : state)
+    {
+        UF uf(n);
+        for (auto [a, b] : edges)
+            uf.unionSet(a, b);
+        int same = 0;
+        for (auto [a, b] : queries)
+            same += uf.isSameSet(a, b);
+        do_not_optimize(same);
+    }
+}
+
+// arg 0: n, arg 1: graph (0 random, 1 path, 2 star, 3 binomial)
+CP_BENCHMARK(BM_UnionFind<UnionFind>)->cross({{1 << 12, 1 << 20}, {RANDOM, PATH, STAR, BINOMIAL}});
+CP_BENCHMARK(BM_UnionFind<CompactUnionFind>)->cross({{1 << 12, 1 << 20}, {RANDOM, PATH, STAR, BINOMIAL}});
+CP_BENCHMARK(BM_UnionFind<RollbackUnionFind>)->cross({{1 << 12, 1 << 20}, {RANDOM, PATH, STAR, BINOMIAL}});
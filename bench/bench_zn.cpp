@@ -0,0 +1,81 @@
+// Zn / MontZn arithmetic: dependent multiply chains (latency), independent
+// element-wise products (throughput) and power() with random exponents.
+
+#include "bench.h"
+#include "generators.h"
+
+#include "../include/number_theory/zn.h"
+#include "../include/number_theory/mont_zn.h"
+
+using namespace cp::bench;
+
+constexpr int MOD = 998244353;
+
+template <typename Z>
+static void BM_MulChain(State &state)
+{
+    Z x(123456789), y(987654321);
+    for (auto _ : state)
+    {
+        x *= y; // each product waits for the previous one
+        do_not_optimize(x);
+    }
+}
+
+template <typename Z>
+static void BM_MulArray(State &state)
+{
+    size_t n = state.arg(0);
+    auto raw_a = gen::random_ints<long long>(n, 0, MOD - 1, 1), raw_b = gen::random_ints<long long>(n, 0, MOD - 1, 2);
+    std::vector<Z> a(raw_a.begin(), raw_a.end()), b(raw_b.begin(), raw_b.end());
+    state.set_items_per_iteration(n);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < n; ++i)
+            a[i] *= b[i];
+        clobber_memory();
+    }
+}
+
+template <typename Z>
+static void BM_Power(State &state)
+{
+    constexpr size_t N = 1024;
+    auto bases = gen::random_ints<long long>(N, 1, MOD - 1, 3);
+    auto exps = gen::random_ints<long long>(N, 0, (1LL << state.arg(0)) - 1, 4);
+    state.set_items_per_iteration(N);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            Z r = Z(bases[i]).power(exps[i]);
+            do_not_optimize(r);
+        }
+    }
+}
+
+template <typename Z>
+static void BM_Inverse(State &state)
+{
+    constexpr size_t N = 1024;
+    auto raw = gen::random_ints<long long>(N, 1, MOD - 1, 5);
+    std::vector<Z> a(raw.begin(), raw.end());
+    state.set_items_per_iteration(N);
+    for (auto _ : state)
+    {
+        for (const Z &z : a)
+        {
+            Z r = z.inverse();
+            do_not_optimize(r);
+        }
+    }
+}
+
+CP_BENCHMARK(BM_MulChain<cp::Zn<MOD>>);
+CP_BENCHMARK(BM_MulChain<cp::MontZn<MOD>>);
+CP_BENCHMARK(BM_MulArray<cp::Zn<MOD>>)->range(1 << 10, 1 << 20, 32);
+CP_BENCHMARK(BM_MulArray<cp::MontZn<MOD>>)->range(1 << 10, 1 << 20, 32);
+CP_BENCHMARK(BM_Power<cp::Zn<MOD>>)->arg(30)->arg(62);
+CP_BENCHMARK(BM_Power<cp::MontZn<MOD>>)->arg(30)->arg(62);
+CP_BENCHMARK(BM_Inverse<cp::Zn<MOD>>);
+CP_BENCHMARK(BM_Inverse<cp::MontZn<MOD>>);
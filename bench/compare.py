@@ -0,0 +1,55 @@
+#!/usr/bin/env python3
+"""Compares two cp_bench JSON reports benchmark by benchmark.
+
+Usage: python3 compare.py OLD.json NEW.json [--threshold=0.05]
+
+Prints ns/item and p99 for both runs and the new/old ratio; ratios outside
+1 +- threshold are marked, and the exit status is 1 if anything got slower.
+"""
+
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        report = json.load(f)
+    return report["context"], {b["name"]: b for b in report["benchmarks"] if not b.get("skipped")}
+
+
+def main(argv):
+    args = [a for a in argv[1:] if not a.startswith("--")]
+    threshold = 0.05
+    for a in argv[1:]:
+        if a.startswith("--threshold="):
+            threshold = float(a.split("=", 1)[1])
+    if len(args) != 2:
+        print(__doc__.strip(), file=sys.stderr)
+        return 2
+
+    old_ctx, old = load(args[0])
+    new_ctx, new = load(args[1])
+    for key in ("compiler", "flags"):
+        if old_ctx.get(key) != new_ctx.get(key):
+            print(f"warning: {key} differs: {old_ctx.get(key)!r} vs {new_ctx.get(key)!r}", file=sys.stderr)
+
+    slower = False
+    print(f"{'Benchmark':<48} {'old ns':>10} {'new ns':>10} {'ratio':>7} {'old p99':>10} {'new p99':>10}")
+    for name in [n for n in new if n in old]:
+        o, n = old[name], new[name]
+        ratio = n["ns_per_item"] / o["ns_per_item"] if o["ns_per_item"] > 0 else float("inf")
+        mark = ""
+        if ratio > 1 + threshold:
+            mark, slower = "  slower", True
+        elif ratio < 1 - threshold:
+            mark = "  faster"
+        print(f"{name:<48} {o['ns_per_item']:>10.3f} {n['ns_per_item']:>10.3f} {ratio:>7.3f} "
+              f"{o['p99_ns']:>10.3f} {n['p99_ns']:>10.3f}{mark}")
+
+    for name in sorted(set(old) ^ set(new)):
+        print(f"{name:<48} only in {'old' if name in old else 'new'}")
+    return 1 if slower else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,121 @@
+#pragma once
+/*
+ * Reproducible and adversarial inputs for the benchmarks
+ * random_ints, random_indices, random_edges      uniform inputs from a fixed seed
+ * path_edges, star_edges, binomial_edges         union-find worst cases
+ * shifted_keys                                   keys equal modulo a power of two
+ * bucket_collision_keys<Map>                     keys sharing one bucket of Map
+ */
+
+// Every generator takes an explicit seed, so two releases are benchmarked on
+// exactly the same inputs.
+//
+// Union-find: path_edges links i with i + 1 in order, which chains naive
+// linking into a path; star_edges merges every vertex into vertex 0;
+// binomial_edges unions sets of equal size pairwise, level by level, which
+// makes union-by-rank trees reach height log n before any compression.
+//
+// Hashing: shifted_keys are multiples of 2^shift and all land in one slot of
+// a power-of-two table with an identity hash (gp_hash_table with std::hash).
+// bucket_collision_keys are multiples of the bucket count a prime-sized table
+// (std::unordered_map) reaches after n inserts, the classic anti-hash test.
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace cp::bench::gen
+{
+    using Edge = std::pair<int, int>;
+
+    /// @brief The seed every benchmark uses unless it needs several independent streams.
+    inline constexpr std::uint64_t DEFAULT_SEED = 0x5eed5eedULL;
+
+    /// @brief n integers drawn uniformly from [lo, hi].
+    template <typename T = long long>
+    std::vector<T> random_ints(size_t n, T lo, T hi, std::uint64_t seed = DEFAULT_SEED)
+    {
+        std::mt19937_64 rng(seed);
+        std::uniform_int_distribution<T> dist(lo, hi);
+        std::vector<T> out(n);
+        for (T &x : out)
+            x = dist(rng);
+        return out;
+    }
+
+    /// @brief n indices drawn uniformly from [0, bound).
+    inline std::vector<int> random_indices(size_t n, int bound, std::uint64_t seed = DEFAULT_SEED)
+    {
+        return random_ints<int>(n, 0, bound - 1, seed);
+    }
+
+    /// @brief m edges with endpoints drawn uniformly from [0, n).
+    inline std::vector<Edge> random_edges(int n, size_t m, std::uint64_t seed = DEFAULT_SEED)
+    {
+        std::mt19937_64 rng(seed);
+        std::uniform_int_distribution<int> dist(0, n - 1);
+        std::vector<Edge> out(m);
+        for (Edge &e : out)
+            e = {dist(rng), dist(rng)};
+        return out;
+    }
+
+    /// @brief (0, 1), (1, 2), ..., (n - 2, n - 1): a single long chain.
+    inline std::vector<Edge> path_edges(int n)
+    {
+        std::vector<Edge> out;
+        for (int i = 0; i + 1 < n; ++i)
+            out.emplace_back(i, i + 1);
+        return out;
+    }
+
+    /// @brief (1, 0), (2, 0), ..., (n - 1, 0): every vertex joins the same set.
+    inline std::vector<Edge> star_edges(int n)
+    {
+        std::vector<Edge> out;
+        for (int i = 1; i < n; ++i)
+            out.emplace_back(i, 0);
+        return out;
+    }
+
+    /// @brief Pairwise unions of equal-size blocks, doubling the block size each round.
+    inline std::vector<Edge> binomial_edges(int n)
+    {
+        std::vector<Edge> out;
+        for (int step = 1; step < n; step *= 2)
+            for (int i = 0; i + step < n; i += 2 * step)
+                out.emplace_back(i + step, i); // the later block's root joins the earlier one
+        return out;
+    }
+
+    /// @brief n distinct keys, all multiples of 2^shift.
+    inline std::vector<long long> shifted_keys(size_t n, int shift = 20, std::uint64_t seed = DEFAULT_SEED)
+    {
+        std::vector<long long> out(n);
+        std::iota(out.begin(), out.end(), 1LL);
+        std::shuffle(out.begin(), out.end(), std::mt19937_64(seed));
+        for (long long &k : out)
+            k <<= shift;
+        return out;
+    }
+
+    /**
+     * @brief n distinct keys that all fall into one bucket of Map once it holds n keys.
+     * @tparam Map A map with a prime bucket count and an identity hash, e.g. std::unordered_map<long long, int>.
+     */
+    template <typename Map>
+    std::vector<long long> bucket_collision_keys(size_t n)
+    {
+        Map probe;
+        for (size_t i = 0; i < n; ++i)
+            probe[static_cast<long long>(i)];
+        long long buckets = static_cast<long long>(probe.bucket_count());
+        std::vector<long long> out(n);
+        for (size_t i = 0; i < n; ++i)
+            out[i] = static_cast<long long>(i + 1) * buckets;
+        return out;
+    }
+}
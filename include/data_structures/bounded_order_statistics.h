@@ -0,0 +1,155 @@
+#pragma once
+/*
+ * Order statistics over a bounded integer universe [0, U)
+ * Operation: O(log U) insert(x), erase(x)
+ * Operation: O(log U) find_by_order(k), order_of_key(x)
+ * Operation: O(log_64 U) predecessor(x), successor(x)
+ * Operation: O(1) count(x), contains(x)
+ */
+
+// Drop-in alternative to OrderStatisticsTree (order_statistics_tree.h) when
+// keys are small integers or can be compressed with CoordinateCompressor.
+// Counts live in a FenwickTree, answering ranks with a prefix sum and
+// selections with FenwickTree::find_kth. A FastSet of the present keys answers
+// predecessor/successor. Everything is a few flat arrays allocated once, so
+// there is no allocation per insert and no pointer chasing.
+//
+// Differences from the pb_ds tree: find_by_order returns the key itself (not
+// an iterator), and keys outside [0, U) are not allowed.
+
+#include <vector>
+#include <cassert>
+
+#include "fenwick_tree.h"
+#include "fast_set.h"
+
+namespace cp
+{
+    /**
+     * @brief An ordered set (or multiset) of integers in [0, U) with rank and select.
+     * @tparam Multi If true, keys may be inserted more than once.
+     */
+    template <bool Multi = false>
+    class BoundedOrderStatisticsSet
+    {
+    private:
+        int m_universe;
+        int m_size = 0;
+        std::vector<int> m_count;
+        FenwickTree<int> m_fenwick;
+        FastSet m_present;
+
+    public:
+        /**
+         * @brief Constructs an empty set over the universe [0, universe).
+         * @complexity O(U)
+         */
+        explicit BoundedOrderStatisticsSet(int universe)
+            : m_universe(universe), m_count(universe, 0), m_fenwick(universe), m_present(universe) {}
+
+        /**
+         * @brief Inserts x. For a set, does nothing if x is already present.
+         * @return Whether the set changed.
+         * @complexity O(log U)
+         */
+        bool insert(int x)
+        {
+            assert(0 <= x && x < m_universe);
+            if (!Multi && m_count[x] > 0)
+                return false;
+            if (m_count[x]++ == 0)
+                m_present.insert(x);
+            m_fenwick.add(x + 1, 1);
+            ++m_size;
+            return true;
+        }
+
+        /**
+         * @brief Erases one copy of x.
+         * @return Whether x was present.
+         * @complexity O(log U)
+         */
+        bool erase(int x)
+        {
+            assert(0 <= x && x < m_universe);
+            if (m_count[x] == 0)
+                return false;
+            if (--m_count[x] == 0)
+                m_present.erase(x);
+            m_fenwick.add(x + 1, -1);
+            --m_size;
+            return true;
+        }
+
+        /// @brief Returns the number of copies of x.
+        int count(int x) const { return m_count[x]; }
+
+        /// @brief Returns whether x is present.
+        bool contains(int x) const { return m_count[x] > 0; }
+
+        /**
+         * @brief Returns the k-th smallest element (0-based), counting duplicates.
+         * @return The element, or U if k >= size().
+         * @complexity O(log U)
+         */
+        int find_by_order(int k) const
+        {
+            if (k < 0 || k >= m_size)
+                return m_universe;
+            return m_fenwick.find_kth(k + 1) - 1;
+        }
+
+        /**
+         * @brief Returns the number of elements strictly less than x.
+         * @complexity O(log U)
+         */
+        int order_of_key(int x) const
+        {
+            if (x <= 0)
+                return 0;
+            return m_fenwick.query(x < m_universe ? x : m_universe);
+        }
+
+        /// @brief Returns the largest element strictly less than x, or -1 if there is none.
+        int predecessor(int x) const { return m_present.prev(x - 1); }
+
+        /// @brief Returns the smallest element strictly greater than x, or U if there is none.
+        int successor(int x) const { return m_present.next(x + 1); }
+
+        /// @brief Returns the smallest element >= x, or U if there is none.
+        int lower_bound(int x) const { return m_present.next(x); }
+
+        /// @brief Returns the smallest element, or U if the set is empty.
+        int min() const { return m_present.next(0); }
+
+        /// @brief Returns the largest element, or -1 if the set is empty.
+        int max() const { return m_present.prev(m_universe - 1); }
+
+        int size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+        int universe() const { return m_universe; }
+    };
+
+    using BoundedOrderStatisticsMultiset = BoundedOrderStatisticsSet<true>;
+}
+
+/*
+int main()
+{
+    // Same queries as the OrderStatisticsTree demo, on compressed keys.
+    std::vector<int> A = {2, 4, 7, 10, 15, 23, 50, 65, 71};
+    cp::CoordinateCompressor<int> cc(A); // coordinate_compressor.h
+    cp::BoundedOrderStatisticsSet<> s(cc.size());
+    for (int x : A)
+        s.insert(cc.index(x));
+
+    printf("%d\n", cc.value(s.find_by_order(4)));       // 15
+    printf("%d\n", s.order_of_key(cc.lower_bound(15))); // 4
+    printf("%d\n", cc.value(s.successor(cc.index(23)))); // 50
+
+    cp::BoundedOrderStatisticsMultiset ms(100);
+    ms.insert(7), ms.insert(7), ms.insert(3);
+    printf("%d %d\n", ms.find_by_order(1), ms.order_of_key(8)); // 7 3
+    return 0;
+}
+*/
@@ -0,0 +1,189 @@
+#pragma once
+/*
+ * Anti-hack hashing for HashTable and cp::FlatHashMap
+ * Integers and enums:          splitmix64(x + seed)
+ * Floating point:              splitmix64(bits + seed), with -0.0 hashed as 0.0
+ * Strings and byte spans:      wyhash-style, 16 bytes per 64x64->128 multiply
+ * Pairs and tuples:            element hashes folded through splitmix64
+ * Other ranges:                element hashes folded, then the length
+ * User types:                  define chash_value(const T &) next to T (ADL)
+ */
+
+// The seed is drawn from the clock once per run, so a precomputed anti-hash
+// test cannot target the hash. Hashing a key never falls back to std::hash.
+//
+// Opting a type in:
+//
+//     struct Point { int x, y; bool operator==(const Point &) const = default; };
+//     uint64_t chash_value(const Point &p) { return chash{}(std::tie(p.x, p.y)); }
+//
+// The result of chash_value is mixed with the seed once more, so it only has
+// to be a good 64-bit summary, not a good hash.
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <bit>
+#include <chrono>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <ranges>
+#include <type_traits>
+
+struct chash
+{
+    static uint64_t splitmix64(uint64_t x)
+    {
+        // http://xorshift.di.unimi.it/splitmix64.c
+        x += 0x9e3779b97f4a7c15;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+        return x ^ (x >> 31);
+    }
+
+    static uint64_t seed()
+    {
+        static const uint64_t FIXED_RANDOM = std::chrono::steady_clock::now().time_since_epoch().count();
+        return FIXED_RANDOM;
+    }
+
+    /**
+     * @brief Hashes n bytes starting at data (wyhash-style).
+     * @complexity O(n)
+     */
+    static uint64_t hash_bytes(const void *data, size_t n, uint64_t seed)
+    {
+        constexpr uint64_t P0 = 0xa0761d6478bd642full, P1 = 0xe7037ed1a0b428dbull, P2 = 0x8ebc6af09c88c6e3ull;
+        const unsigned char *p = static_cast<const unsigned char *>(data);
+        seed ^= mum(seed ^ P0, P1);
+        uint64_t a = 0, b = 0;
+        if (n <= 16)
+        {
+            if (n >= 8)
+                a = read64(p), b = read64(p + n - 8);
+            else if (n >= 4)
+                a = read32(p), b = read32(p + n - 4);
+            else if (n > 0)
+                a = (uint64_t(p[0]) << 16) | (uint64_t(p[n >> 1]) << 8) | p[n - 1];
+        }
+        else
+        {
+            size_t i = n;
+            for (; i > 16; i -= 16, p += 16)
+                seed = mum(read64(p) ^ P1, read64(p + 8) ^ seed);
+            a = read64(p + i - 16), b = read64(p + i - 8);
+        }
+        return mum(P1 ^ n, mum(a ^ P1, b ^ seed ^ P2));
+    }
+
+    template <typename T>
+    size_t operator()(const T &x) const
+    {
+        return static_cast<size_t>(hash(x));
+    }
+
+private:
+    static uint64_t mum(uint64_t a, uint64_t b)
+    {
+        __uint128_t r = static_cast<__uint128_t>(a) * b;
+        return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+    }
+
+    static uint64_t read64(const unsigned char *p)
+    {
+        uint64_t v;
+        std::memcpy(&v, p, 8);
+        return v;
+    }
+
+    static uint64_t read32(const unsigned char *p)
+    {
+        uint32_t v;
+        std::memcpy(&v, p, 4);
+        return v;
+    }
+
+    template <typename T>
+    static constexpr bool is_tuple_like = requires { std::tuple_size<T>::value; };
+
+    /// @brief Contiguous ranges whose bytes determine equality can be hashed as one block.
+    template <typename T>
+    static constexpr bool is_byte_range = []
+    {
+        if constexpr (std::ranges::contiguous_range<const T &>)
+            return std::has_unique_object_representations_v<std::ranges::range_value_t<const T &>>;
+        else
+            return false;
+    }();
+
+    template <typename T>
+    static uint64_t hash(const T &x)
+    {
+        if constexpr (requires { { chash_value(x) } -> std::convertible_to<uint64_t>; })
+        {
+            return splitmix64(static_cast<uint64_t>(chash_value(x)) + seed());
+        }
+        else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>)
+        {
+            return splitmix64(static_cast<uint64_t>(x) + seed());
+        }
+        else if constexpr (std::is_floating_point_v<T>)
+        {
+            // Equal values must hash equally: -0.0 == 0.0 but their bits differ.
+            // long double has padding bytes, so it is hashed through double.
+            if constexpr (sizeof(T) == sizeof(uint32_t))
+                return splitmix64(std::bit_cast<uint32_t>(x == 0 ? T(0) : x) + seed());
+            else if constexpr (sizeof(T) == sizeof(uint64_t))
+                return splitmix64(std::bit_cast<uint64_t>(x == 0 ? T(0) : x) + seed());
+            else
+                return hash(static_cast<double>(x));
+        }
+        else if constexpr (std::is_convertible_v<const T &, std::string_view>)
+        {
+            std::string_view s = x;
+            return hash_bytes(s.data(), s.size(), seed());
+        }
+        else if constexpr (is_byte_range<T>)
+        {
+            return hash_bytes(std::ranges::data(x), std::ranges::size(x) * sizeof(*std::ranges::data(x)), seed());
+        }
+        else if constexpr (is_tuple_like<T>)
+        {
+            return std::apply([](const auto &...xs)
+                              {
+                                  uint64_t h = seed();
+                                  ((h = splitmix64(h + hash(xs))), ...);
+                                  return h; },
+                              x);
+        }
+        else if constexpr (std::ranges::input_range<const T &>)
+        {
+            uint64_t h = seed(), n = 0;
+            for (const auto &e : x)
+                h = splitmix64(h + hash(e)), ++n;
+            return splitmix64(h + n);
+        }
+        else
+        {
+            static_assert(!sizeof(T), "chash: no hash for this type; define chash_value(const T &) next to it.");
+        }
+    }
+};
+
+/*
+int main()
+{
+    HashTable<std::pair<int, int>, int> grid;    // hash_table.h
+    cp::FlatHashMap<std::string, int> words;    // flat_hash_map.h
+    cp::FlatHashMap<std::tuple<int, int, char>, long long> dp;
+
+    grid[{3, -4}] = 1;
+    words["abc"]++;
+    dp[{1, 2, 'x'}] += 5;
+
+    std::vector<int> v = {1, 2, 3};
+    printf("%d\n", chash{}(v) == chash{}(std::array<int, 3>{1, 2, 3})); // 1: same bytes
+    return 0;
+}
+*/
@@ -0,0 +1,325 @@
+#pragma once
+/*
+ * Sharded concurrent hash map
+ * Operation: O(1) expected insert_or_add(key, delta), insert, find, contains, erase
+ * Operation: O(k + shards) insert_or_add(batch of k), one lock per touched shard
+ * Operation: O((n + shards) / threads) merge(tables, threads) of n entries
+ */
+
+// The map is split into a power-of-two number of shards, each a FlatHashMap
+// behind its own test-and-test-and-set spinlock on a separate cache line. The
+// top bits of the key's hash pick the shard (FlatHashMap slots are chosen by
+// multiplying the whole hash, so keys sharing a shard still spread inside it).
+// Threads touching different shards never contend.
+//
+// The batched insert_or_add sorts a batch by shard first and then takes each
+// lock once. merge() never locks: every worker first splits its own input
+// tables by destination shard, then each worker owns a disjoint set of shards
+// and folds every bucket addressed to them. Both phases are parallel, so the
+// reduction of per-thread counting tables scales with the number of cores.
+
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <span>
+#include <bit>
+
+#include "flat_hash_map.h"
+
+namespace cp
+{
+    /**
+     * @brief A hash map that many threads can update at once, sharded over FlatHashMap.
+     * @tparam K The key type.
+     * @tparam V The mapped type; insert_or_add and merge need `+=`.
+     * @tparam Hash The hash function, chash by default.
+     * @tparam KeyEqual The key equality predicate.
+     */
+    template <typename K, typename V, typename Hash = chash, typename KeyEqual = std::equal_to<K>>
+    class ConcurrentHashMap
+    {
+    public:
+        using shard_type = FlatHashMap<K, V, Hash, KeyEqual>;
+
+    private:
+        class SpinLock
+        {
+            std::atomic<bool> m_locked{false};
+
+        public:
+            void lock()
+            {
+                while (m_locked.exchange(true, std::memory_order_acquire))
+                {
+                    while (m_locked.load(std::memory_order_relaxed))
+                    {
+#if defined(__x86_64__) || defined(__i386__)
+                        __builtin_ia32_pause();
+#endif
+                    }
+                }
+            }
+
+            void unlock() { m_locked.store(false, std::memory_order_release); }
+        };
+
+        struct alignas(64) Shard
+        {
+            SpinLock lock;
+            shard_type map;
+        };
+
+        std::vector<Shard> m_shards;
+        int m_shift;
+        Hash m_hash;
+
+        size_t shard_of(const K &key) const
+        {
+            return m_shift == 64 ? 0 : static_cast<size_t>(static_cast<std::uint64_t>(m_hash(key)) >> m_shift);
+        }
+
+        template <typename Body>
+        static void parallel_for(size_t count, unsigned threads, Body &&body)
+        {
+            threads = std::max(1u, threads);
+            if (threads == 1 || count <= 1)
+            {
+                for (size_t i = 0; i < count; ++i)
+                    body(i);
+                return;
+            }
+            std::vector<std::thread> pool;
+            size_t chunk = (count + threads - 1) / threads;
+            for (size_t lo = 0; lo < count; lo += chunk)
+            {
+                size_t hi = std::min(count, lo + chunk);
+                pool.emplace_back([&body, lo, hi]
+                                  { for (size_t i = lo; i < hi; ++i) body(i); });
+            }
+            for (auto &th : pool)
+            {
+                th.join();
+            }
+        }
+
+    public:
+        /**
+         * @brief Constructs an empty map.
+         * @param shards The number of shards, rounded up to a power of two. About
+         *        4-8 per thread keeps contention low.
+         * @param expected The expected total number of keys, reserved evenly across shards.
+         */
+        explicit ConcurrentHashMap(size_t shards = 64, size_t expected = 0)
+            : m_shards(std::bit_ceil(std::max<size_t>(shards, 1))),
+              m_shift(64 - std::countr_zero(m_shards.size()))
+        {
+            if (expected > 0)
+            {
+                for (Shard &s : m_shards)
+                    s.map.reserve(expected / m_shards.size() + 1);
+            }
+        }
+
+        /**
+         * @brief Adds delta to the value of key, inserting V() + delta if absent.
+         * @complexity O(1) expected; locks one shard.
+         */
+        void insert_or_add(const K &key, const V &delta)
+        {
+            Shard &s = m_shards[shard_of(key)];
+            std::lock_guard guard(s.lock);
+            s.map[key] += delta;
+        }
+
+        /**
+         * @brief Applies a batch of (key, delta) updates, taking each shard's lock once.
+         * @complexity O(k + shards) expected for k updates.
+         */
+        void insert_or_add(std::span<const std::pair<K, V>> batch)
+        {
+            // Counting sort of the batch indices by shard.
+            std::vector<size_t> start(m_shards.size() + 1, 0), order(batch.size()), shard(batch.size());
+            for (size_t i = 0; i < batch.size(); ++i)
+            {
+                shard[i] = shard_of(batch[i].first);
+                ++start[shard[i] + 1];
+            }
+            for (size_t s = 0; s < m_shards.size(); ++s)
+                start[s + 1] += start[s];
+            std::vector<size_t> fill(start.begin(), start.end() - 1);
+            for (size_t i = 0; i < batch.size(); ++i)
+                order[fill[shard[i]]++] = i;
+
+            for (size_t s = 0; s < m_shards.size(); ++s)
+            {
+                if (start[s] == start[s + 1])
+                    continue;
+                std::lock_guard guard(m_shards[s].lock);
+                shard_type &map = m_shards[s].map;
+                for (size_t j = start[s]; j < start[s + 1]; ++j)
+                    map[batch[order[j]].first] += batch[order[j]].second;
+            }
+        }
+
+        /**
+         * @brief Inserts (key, value) if key is absent.
+         * @return Whether an insertion took place.
+         */
+        bool insert(const K &key, const V &value)
+        {
+            Shard &s = m_shards[shard_of(key)];
+            std::lock_guard guard(s.lock);
+            return s.map.insert(key, value).second;
+        }
+
+        /**
+         * @brief Calls f(value) under the shard's lock, inserting V() first if key is absent.
+         * @param f Must not access this map.
+         */
+        template <typename F>
+        void update(const K &key, F &&f)
+        {
+            Shard &s = m_shards[shard_of(key)];
+            std::lock_guard guard(s.lock);
+            f(s.map[key]);
+        }
+
+        /// @brief Returns a copy of the value for key, if present.
+        std::optional<V> find(const K &key)
+        {
+            Shard &s = m_shards[shard_of(key)];
+            std::lock_guard guard(s.lock);
+            auto it = s.map.find(key);
+            if (it == s.map.end())
+                return std::nullopt;
+            return it->second;
+        }
+
+        bool contains(const K &key)
+        {
+            Shard &s = m_shards[shard_of(key)];
+            std::lock_guard guard(s.lock);
+            return s.map.contains(key);
+        }
+
+        /// @brief Removes key. Returns whether it was present.
+        bool erase(const K &key)
+        {
+            Shard &s = m_shards[shard_of(key)];
+            std::lock_guard guard(s.lock);
+            return s.map.erase(key) == 1;
+        }
+
+        /**
+         * @brief Adds every (key, value) of the given tables into this map, in parallel, without locks.
+         * @param tables Any maps iterable as (key, value) pairs, e.g. one FlatHashMap per thread.
+         * @param threads The number of worker threads.
+         * @pre No other thread uses this map during the merge.
+         * @complexity O((n + shards * tables) / threads) for n entries in total.
+         */
+        template <typename Map>
+        void merge(const std::vector<Map> &tables, unsigned threads = std::thread::hardware_concurrency())
+        {
+            size_t shards = m_shards.size();
+            // Phase 1: split every table into one bucket per destination shard.
+            std::vector<std::vector<std::vector<std::pair<K, V>>>> buckets(tables.size());
+            parallel_for(tables.size(), threads, [&](size_t t)
+                         {
+                auto &out = buckets[t];
+                out.resize(shards);
+                for (const auto &[key, value] : tables[t])
+                    out[shard_of(key)].emplace_back(key, value); });
+
+            // Phase 2: shard s is written only by the worker that owns it.
+            parallel_for(shards, threads, [&](size_t s)
+                         {
+                shard_type &map = m_shards[s].map;
+                size_t incoming = 0;
+                for (const auto &b : buckets)
+                    incoming += b[s].size();
+                map.reserve(map.size() + incoming);
+                for (const auto &b : buckets)
+                    for (const auto &[key, value] : b[s])
+                        map[key] += value; });
+        }
+
+        /**
+         * @brief The number of keys. Exact only while no other thread is writing.
+         * @complexity O(shards)
+         */
+        size_t size()
+        {
+            size_t total = 0;
+            for (Shard &s : m_shards)
+            {
+                std::lock_guard guard(s.lock);
+                total += s.map.size();
+            }
+            return total;
+        }
+
+        /// @brief Removes every key, keeping the capacity.
+        void clear()
+        {
+            for (Shard &s : m_shards)
+            {
+                std::lock_guard guard(s.lock);
+                s.map.clear();
+            }
+        }
+
+        /**
+         * @brief Calls f(key, value) for every entry.
+         * @pre No other thread is writing.
+         */
+        template <typename F>
+        void for_each(F &&f) const
+        {
+            for (const Shard &s : m_shards)
+                for (const auto &[key, value] : s.map)
+                    f(key, value);
+        }
+
+        size_t shard_count() const { return m_shards.size(); }
+
+        /// @brief Direct access to one shard, e.g. to iterate after all writers have finished.
+        const shard_type &shard(size_t i) const { return m_shards[i].map; }
+    };
+}
+
+/*
+int main()
+{
+    std::vector<int> data(1 << 20);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = (i * 2654435761u) % 1000;
+
+    // Shared map: every thread updates it directly, in batches.
+    cp::ConcurrentHashMap<int, long long> counts(32);
+    std::vector<std::thread> pool;
+    for (int t = 0; t < 4; ++t)
+        pool.emplace_back([&, t]
+                          {
+            std::vector<std::pair<int, long long>> batch;
+            for (size_t i = t; i < data.size(); i += 4)
+                batch.emplace_back(data[i], 1);
+            counts.insert_or_add(batch); });
+    for (auto &th : pool)
+        th.join();
+
+    // Per-thread tables, reduced in parallel.
+    std::vector<cp::FlatHashMap<int, long long>> local(4);
+    for (size_t i = 0; i < data.size(); ++i)
+        local[i % 4][data[i]]++;
+    cp::ConcurrentHashMap<int, long long> merged;
+    merged.merge(local, 4);
+
+    printf("%lld %lld %zu\n", *counts.find(7), *merged.find(7), merged.size()); // 1048 1048 1000
+    return 0;
+}
+*/
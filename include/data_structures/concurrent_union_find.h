@@ -0,0 +1,161 @@
+#pragma once
+/*
+ * Concurrent Union-Find Disjoint Sets
+ * UFDS Operation: wait-free findSet(i)
+ * UFDS Operation: lock-free unionSet(i, j), isSameSet(i, j)
+ * Operation: O((n + m) alpha / threads) connected_components(edges, n, threads)
+ */
+
+// Parents are std::atomic<int>. Roots are always linked under the root with
+// the smaller index, so parent pointers only ever decrease (p[i] <= i). That
+// rules out cycles without locks, makes the root of every set its minimum
+// element, and bounds every findSet walk by i steps no matter what other
+// threads do. findSet compresses with a single CAS per step (path halving)
+// and never retries a failed CAS, so it stays wait-free.
+
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <algorithm>
+
+namespace cp
+{
+    /**
+     * @brief A union-find structure that many threads can update at once.
+     *
+     * Method names follow UnionFind (union_find.h). Set sizes are not tracked.
+     */
+    class ConcurrentUnionFind
+    {
+    private:
+        std::vector<std::atomic<int>> p;
+        std::atomic<int> numSets;
+
+    public:
+        explicit ConcurrentUnionFind(int N) : p(N), numSets(N)
+        {
+            for (int i = 0; i < N; ++i)
+            {
+                p[i].store(i, std::memory_order_relaxed);
+            }
+        }
+
+        int findSet(int i)
+        {
+            while (true)
+            {
+                int parent = p[i].load(std::memory_order_acquire);
+                if (parent == i)
+                {
+                    return i;
+                }
+                int grand = p[parent].load(std::memory_order_acquire);
+                if (parent != grand)
+                {
+                    p[i].compare_exchange_weak(parent, grand, std::memory_order_release, std::memory_order_relaxed);
+                }
+                i = grand;
+            }
+        }
+
+        bool isSameSet(int i, int j)
+        {
+            while (true)
+            {
+                i = findSet(i), j = findSet(j);
+                if (i == j)
+                {
+                    return true;
+                }
+                // i was a root when found; if it still is, the sets were disjoint at that moment.
+                if (p[i].load(std::memory_order_acquire) == i)
+                {
+                    return false;
+                }
+            }
+        }
+
+        int numDisjointSets() const
+        {
+            return numSets.load(std::memory_order_relaxed);
+        }
+
+        // Returns true if this call merged two different sets.
+        bool unionSet(int i, int j)
+        {
+            while (true)
+            {
+                i = findSet(i), j = findSet(j);
+                if (i == j)
+                {
+                    return false;
+                }
+                if (i < j)
+                {
+                    std::swap(i, j);
+                }
+                int expected = i;
+                if (p[i].compare_exchange_strong(expected, j, std::memory_order_acq_rel, std::memory_order_relaxed))
+                {
+                    numSets.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+        }
+    };
+
+    /**
+     * @brief Labels connected components using several threads.
+     * @param edges Undirected edges over vertices 0..n-1.
+     * @param n The number of vertices.
+     * @param threads The number of worker threads (0 means hardware concurrency).
+     * @return For each vertex, the smallest vertex index in its component.
+     */
+    inline std::vector<int> connected_components(const std::vector<std::pair<int, int>> &edges, int n,
+                                                 unsigned threads = std::thread::hardware_concurrency())
+    {
+        threads = std::max(1u, threads);
+        ConcurrentUnionFind dsu(n);
+
+        auto parallel_for = [threads](size_t count, auto &&body)
+        {
+            std::vector<std::thread> pool;
+            size_t chunk = (count + threads - 1) / threads;
+            for (unsigned t = 0; t < threads; ++t)
+            {
+                size_t lo = t * chunk, hi = std::min(count, lo + chunk);
+                if (lo >= hi)
+                {
+                    break;
+                }
+                pool.emplace_back([&body, lo, hi]
+                                  { for (size_t i = lo; i < hi; ++i) body(i); });
+            }
+            for (auto &th : pool)
+            {
+                th.join();
+            }
+        };
+
+        parallel_for(edges.size(), [&](size_t k)
+                     { dsu.unionSet(edges[k].first, edges[k].second); });
+
+        std::vector<int> labels(n);
+        parallel_for(static_cast<size_t>(n), [&](size_t v)
+                     { labels[v] = dsu.findSet(static_cast<int>(v)); });
+        return labels;
+    }
+}
+
+/*
+int main()
+{
+    std::vector<std::pair<int, int>> edges = {{0, 1}, {2, 3}, {4, 3}, {6, 5}};
+    std::vector<int> label = cp::connected_components(edges, 7, 4);
+
+    for (int v = 0; v < 7; ++v)
+        printf("%d -> %d\n", v, label[v]); // 0 0 2 2 2 5 5
+    return 0;
+}
+*/
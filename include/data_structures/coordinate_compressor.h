@@ -0,0 +1,113 @@
+#pragma once
+/*
+ * Offline coordinate compression
+ * Operation: O(1) amortized add(x)
+ * Operation: O(k log k) build() for k added values
+ * Operation: O(log k) index(x), O(1) value(i)
+ */
+
+// Collect every value that will ever be used as a key, call build(), then map
+// values to dense ranks 0..size()-1. Lets bounded-universe structures
+// (FenwickTree, FastSet, BoundedOrderStatisticsSet) index arbitrary keys.
+
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include <functional>
+
+namespace cp
+{
+    /**
+     * @brief Maps a fixed set of values to their ranks among the distinct values.
+     * @tparam T A value type with a strict weak ordering.
+     */
+    template <typename T, typename Compare = std::less<T>>
+    class CoordinateCompressor
+    {
+    private:
+        std::vector<T> m_values;
+        bool m_built = false;
+        Compare m_less;
+
+    public:
+        CoordinateCompressor() = default;
+
+        /// @brief Collects the given values and builds immediately.
+        explicit CoordinateCompressor(std::vector<T> values, Compare less = Compare())
+            : m_values(std::move(values)), m_less(less)
+        {
+            build();
+        }
+
+        /// @brief Records a value. Must be called before build().
+        void add(const T &x)
+        {
+            assert(!m_built);
+            m_values.push_back(x);
+        }
+
+        /**
+         * @brief Sorts and deduplicates the recorded values.
+         * @complexity O(k log k)
+         */
+        void build()
+        {
+            std::sort(m_values.begin(), m_values.end(), m_less);
+            m_values.erase(std::unique(m_values.begin(), m_values.end(), [this](const T &a, const T &b)
+                                       { return !m_less(a, b) && !m_less(b, a); }),
+                           m_values.end());
+            m_built = true;
+        }
+
+        /**
+         * @brief Returns the rank of a value that was added before build().
+         * @complexity O(log k)
+         */
+        int index(const T &x) const
+        {
+            assert(m_built && contains(x));
+            return lower_bound(x);
+        }
+
+        /// @brief Returns the number of distinct values strictly less than x (x need not have been added).
+        int lower_bound(const T &x) const
+        {
+            return static_cast<int>(std::lower_bound(m_values.begin(), m_values.end(), x, m_less) - m_values.begin());
+        }
+
+        /// @brief Returns the number of distinct values less than or equal to x.
+        int upper_bound(const T &x) const
+        {
+            return static_cast<int>(std::upper_bound(m_values.begin(), m_values.end(), x, m_less) - m_values.begin());
+        }
+
+        /// @brief Returns whether x was added before build().
+        bool contains(const T &x) const
+        {
+            int i = lower_bound(x);
+            return i < size() && !m_less(x, m_values[i]);
+        }
+
+        /// @brief Returns the value with rank i.
+        const T &value(int i) const { return m_values[i]; }
+
+        /// @brief Returns the number of distinct values.
+        int size() const { return static_cast<int>(m_values.size()); }
+
+        /// @brief Returns the distinct values in increasing order.
+        const std::vector<T> &values() const { return m_values; }
+    };
+}
+
+/*
+int main()
+{
+    std::vector<long long> A = {1000000000000LL, -5, 42, -5};
+    cp::CoordinateCompressor<long long> cc(A);
+
+    for (long long x : A)
+        printf("%d ", cc.index(x)); // 2 0 1 0
+    printf("\n%d %lld\n", cc.size(), cc.value(1)); // 3 42
+    return 0;
+}
+*/
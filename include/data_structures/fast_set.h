@@ -0,0 +1,161 @@
+#pragma once
+/*
+ * 64-ary bitset tree over [0, n)
+ * Operation: O(log_64 n) insert(i), erase(i)
+ * Operation: O(1) contains(i)
+ * Operation: O(log_64 n) next(i), prev(i)
+ */
+
+// Level 0 is a plain bitset of n bits. Bit j of level h + 1 is set when word j
+// of level h is non-zero, so every level is 64 times smaller than the one
+// below and n = 2^24 needs four levels. Successor and predecessor climb until
+// a word has a set bit on the right side, then descend with one ctz/clz per
+// level. The whole structure is n / 63 words, so it stays in cache where a
+// std::set<int> of the same keys would not.
+
+#include <vector>
+#include <bit>
+#include <cstdint>
+#include <cassert>
+#include <algorithm>
+
+namespace cp
+{
+    /**
+     * @brief A set of integers in [0, n) with fast successor and predecessor.
+     */
+    class FastSet
+    {
+    private:
+        static constexpr int B = 64;
+
+        int m_n;
+        /// @brief m_seg[0] holds the elements; m_seg[h + 1] summarizes the non-zero words of m_seg[h].
+        std::vector<std::vector<std::uint64_t>> m_seg;
+
+    public:
+        /**
+         * @brief Constructs an empty set over the universe [0, n).
+         * @complexity O(n / 64)
+         */
+        explicit FastSet(int n = 0) : m_n(n)
+        {
+            int len = n;
+            do
+            {
+                m_seg.emplace_back((len + B - 1) / B);
+                len = (len + B - 1) / B;
+            } while (len > 1);
+        }
+
+        /// @brief Returns whether i is in the set.
+        bool contains(int i) const
+        {
+            assert(0 <= i && i < m_n);
+            return (m_seg[0][i / B] >> (i % B)) & 1;
+        }
+
+        /// @brief Inserts i; does nothing if it is already present.
+        void insert(int i)
+        {
+            assert(0 <= i && i < m_n);
+            for (auto &level : m_seg)
+            {
+                level[i / B] |= std::uint64_t(1) << (i % B);
+                i /= B;
+            }
+        }
+
+        /// @brief Erases i; does nothing if it is absent.
+        void erase(int i)
+        {
+            assert(0 <= i && i < m_n);
+            for (auto &level : m_seg)
+            {
+                level[i / B] &= ~(std::uint64_t(1) << (i % B));
+                if (level[i / B] != 0)
+                    break;
+                i /= B;
+            }
+        }
+
+        /**
+         * @brief Returns the smallest element >= i, or n if there is none.
+         * @complexity O(log_64 n)
+         */
+        int next(int i) const
+        {
+            if (i < 0)
+                i = 0;
+            if (i >= m_n)
+                return m_n;
+            for (size_t h = 0; h < m_seg.size(); ++h)
+            {
+                if (static_cast<size_t>(i / B) == m_seg[h].size())
+                    break;
+                std::uint64_t d = m_seg[h][i / B] >> (i % B);
+                if (d == 0)
+                {
+                    i = i / B + 1;
+                    continue;
+                }
+                i += std::countr_zero(d);
+                for (size_t g = h; g-- > 0;)
+                    i = i * B + std::countr_zero(m_seg[g][i]);
+                return i;
+            }
+            return m_n;
+        }
+
+        /**
+         * @brief Returns the largest element <= i, or -1 if there is none.
+         * @complexity O(log_64 n)
+         */
+        int prev(int i) const
+        {
+            if (i >= m_n)
+                i = m_n - 1;
+            for (size_t h = 0; h < m_seg.size(); ++h)
+            {
+                if (i < 0)
+                    break;
+                std::uint64_t d = m_seg[h][i / B] << (B - 1 - i % B);
+                if (d == 0)
+                {
+                    i = i / B - 1;
+                    continue;
+                }
+                i -= std::countl_zero(d);
+                for (size_t g = h; g-- > 0;)
+                    i = i * B + (B - 1 - std::countl_zero(m_seg[g][i]));
+                return i;
+            }
+            return -1;
+        }
+
+        /// @brief Removes every element.
+        void clear()
+        {
+            for (auto &level : m_seg)
+                std::fill(level.begin(), level.end(), 0);
+        }
+
+        /// @brief Returns the size of the universe (n), not the number of elements.
+        int universe() const { return m_n; }
+    };
+}
+
+/*
+int main()
+{
+    cp::FastSet fs(1000000);
+    fs.insert(5);
+    fs.insert(70000);
+    fs.insert(999999);
+
+    printf("%d %d\n", fs.next(6), fs.prev(69999)); // 70000 5
+    fs.erase(70000);
+    printf("%d %d\n", fs.next(6), fs.next(1000000)); // 999999 1000000 (none)
+    return 0;
+}
+*/
@@ -6,6 +6,10 @@
  * Operation: O(log m) update(i, v)
  * Operation: O(n + m) build(frequency-array f)
  * Operation: O(log2 m) select(rank k)
+ * Operation: O(min(k log m, m + k)) add_many(k updates), query_many(k indices)
+ * Operation: O(1) snapshot(), O(m) restore(tree)
+ * FenwickRUPQ: O(log m) range_add(i, j, v), point_query(i)
+ * FenwickRURQ: O(log m) range_add(i, j, v), query_range(i, j)
  */
 
 // ========================================================================= //
@@ -33,7 +37,11 @@
 #include <vector>
 #include <type_traits>
 #include <numeric>
-#include <cmath> // For std::log2
+#include <span>
+#include <bit>
+#include <stdexcept>
+#include <utility>
+#include <iterator>
 
 namespace cp
 {
@@ -52,14 +60,40 @@ namespace cp
         /// @brief The internal storage for the Fenwick Tree. Size is N+1.
         std::vector<T> m_tree;
 
+        /// @brief The largest power of two not exceeding N (0 if N == 0), the first step of find_kth.
+        size_t m_log_bit = 0;
+
         /**
          * @brief Calculates the least significant one bit of an integer.
          * @param i The input integer.
          * @return The value of the least significant bit.
          */
-        static constexpr int lso(int i)
+        static constexpr size_t lso(size_t i)
         {
-            return i & -i;
+            return i & (~i + 1);
+        }
+
+        /**
+         * @brief Turns m_tree[1..N], holding raw values, into Fenwick form in place.
+         * @complexity O(N)
+         */
+        static void accumulate_in_place(std::vector<T> &a)
+        {
+            size_t n = a.size() - 1;
+            for (size_t i = 1; i <= n; ++i)
+            {
+                size_t parent = i + lso(i);
+                if (parent <= n)
+                {
+                    a[parent] += a[i];
+                }
+            }
+        }
+
+        /// @brief Chooses the O(N) whole-array path over k separate O(log N) operations.
+        bool prefers_linear(size_t k) const
+        {
+            return k * std::bit_width(size()) >= size();
         }
 
     public:
@@ -68,7 +102,7 @@ namespace cp
          * @param size The number of elements (N). The tree will be size N+1.
          * @complexity O(N)
          */
-        FenwickTree(size_t size) : m_tree(size + 1, T(0)) {}
+        FenwickTree(size_t size) : m_tree(size + 1, T(0)), m_log_bit(std::bit_floor(size)) {}
 
         /**
          * @brief Constructs a Fenwick Tree from an initial list of values.
@@ -87,18 +121,17 @@ namespace cp
          * @complexity O(M + K) where M is max_value and K is the number of items.
          */
         FenwickTree(size_t max_value, const std::vector<int> &items)
+            : m_tree(max_value + 1, T(0)), m_log_bit(std::bit_floor(max_value))
         {
-            std::vector<T> frequencies(max_value + 1, T(0));
+            // Count straight into the tree, then accumulate in place.
             for (int item : items)
             {
-                if (item > 0 && item <= max_value)
+                if (item > 0 && static_cast<size_t>(item) <= max_value)
                 {
-                    ++frequencies[item];
+                    ++m_tree[item];
                 }
             }
-            // Build requires a 0-indexed vector, but frequencies are 1-indexed.
-            // Create a temporary 0-indexed vector from the frequencies.
-            build(std::vector<T>(frequencies.begin() + 1, frequencies.end()));
+            accumulate_in_place(m_tree);
         }
 
         /**
@@ -107,21 +140,28 @@ namespace cp
          */
         void build(const std::vector<T> &values)
         {
-            size_t n = values.size();
-            m_tree.assign(n + 1, T(0));
-            for (size_t i = 0; i < n; ++i)
+            build(values.begin(), values.end());
+        }
+
+        /**
+         * @brief Re-initializes the tree from the values in [first, last), read once.
+         * @param first, last A range of initial values; element k goes to index k + 1.
+         * @complexity O(N)
+         */
+        template <typename InputIt>
+        void build(InputIt first, InputIt last)
+        {
+            m_tree.assign(1, T(0));
+            if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>)
             {
-                m_tree[i + 1] = values[i];
+                m_tree.reserve(std::distance(first, last) + 1);
             }
-
-            for (size_t i = 1; i <= n; ++i)
+            for (; first != last; ++first)
             {
-                size_t parent = i + lso(i);
-                if (parent <= n)
-                {
-                    m_tree[parent] += m_tree[i];
-                }
+                m_tree.push_back(static_cast<T>(*first));
             }
+            m_log_bit = std::bit_floor(size());
+            accumulate_in_place(m_tree);
         }
 
         /**
@@ -132,9 +172,37 @@ namespace cp
          */
         void add(int i, T delta)
         {
-            for (; i < m_tree.size(); i += lso(i))
+            for (size_t k = i; k < m_tree.size(); k += lso(k))
+            {
+                m_tree[k] += delta;
+            }
+        }
+
+        /**
+         * @brief Applies a batch of point updates.
+         * @param updates Pairs of (1-based index, delta), in any order.
+         * @complexity O(min(K log N, N + K)) for K updates: large batches are
+         * scattered into a delta array that is accumulated and added in one sweep.
+         */
+        void add_many(std::span<const std::pair<int, T>> updates)
+        {
+            if (!prefers_linear(updates.size()))
+            {
+                for (const auto &[i, delta] : updates)
+                {
+                    add(i, delta);
+                }
+                return;
+            }
+            std::vector<T> delta(m_tree.size(), T(0));
+            for (const auto &[i, d] : updates)
             {
-                m_tree[i] += delta;
+                delta[i] += d;
+            }
+            accumulate_in_place(delta);
+            for (size_t k = 1; k < m_tree.size(); ++k)
+            {
+                m_tree[k] += delta[k];
             }
         }
 
@@ -147,13 +215,52 @@ namespace cp
         T query(int j) const
         {
             T sum = T(0);
-            for (; j > 0; j -= lso(j))
+            for (size_t k = j; k > 0; k -= lso(k))
             {
-                sum += m_tree[j];
+                sum += m_tree[k];
             }
             return sum;
         }
 
+        /**
+         * @brief Calculates many prefix sums at once.
+         * @param indices 1-based end indices, in any order.
+         * @return The sums of [1, j] for each j in `indices`, in the same order.
+         * @complexity O(min(K log N, N + K)) for K queries: large batches expand
+         * the tree into plain prefix sums in one sweep.
+         */
+        std::vector<T> query_many(std::span<const int> indices) const
+        {
+            std::vector<T> res(indices.size());
+            if (!prefers_linear(indices.size()))
+            {
+                for (size_t q = 0; q < indices.size(); ++q)
+                {
+                    res[q] = query(indices[q]);
+                }
+                return res;
+            }
+            // Recover the raw values: going from n down, subtract each node's tree sum,
+            // still untouched by its own children, from its parent i + lso(i).
+            // Then prefix-sum the raw values.
+            std::vector<T> prefix(m_tree);
+            size_t n = size();
+            for (size_t i = n; i >= 1; --i)
+            {
+                size_t parent = i + lso(i);
+                if (parent <= n)
+                {
+                    prefix[parent] -= prefix[i];
+                }
+            }
+            std::partial_sum(prefix.begin(), prefix.end(), prefix.begin());
+            for (size_t q = 0; q < indices.size(); ++q)
+            {
+                res[q] = prefix[indices[q]];
+            }
+            return res;
+        }
+
         /**
          * @brief Calculates the sum of the range [i, j].
          * @param i The 1-based start index of the range.
@@ -179,23 +286,18 @@ namespace cp
          */
         int find_kth(T k) const
         {
-            int pos = 0;
+            size_t pos = 0;
             T current_sum = T(0);
 
-            int log_n = m_tree.empty() ? 0 : static_cast<int>(std::log2(m_tree.size() - 1));
-
-            for (int bit = (1 << log_n); bit > 0; bit >>= 1)
+            for (size_t bit = m_log_bit; bit > 0; bit >>= 1)
             {
-                if (pos + bit < m_tree.size())
+                if (pos + bit < m_tree.size() && current_sum + m_tree[pos + bit] < k)
                 {
-                    if (current_sum + m_tree[pos + bit] < k)
-                    {
-                        current_sum += m_tree[pos + bit];
-                        pos += bit;
-                    }
+                    current_sum += m_tree[pos + bit];
+                    pos += bit;
                 }
             }
-            return pos + 1;
+            return static_cast<int>(pos + 1);
         }
 
         /**
@@ -206,93 +308,215 @@ namespace cp
         {
             return m_tree.size() - 1;
         }
+
+        /**
+         * @brief The internal tree array (N + 1 entries, entry 0 unused), e.g. for binary_io.h.
+         * @complexity O(1)
+         */
+        std::span<const T> snapshot() const
+        {
+            return m_tree;
+        }
+
+        /**
+         * @brief Replaces the tree with an array previously returned by snapshot().
+         * @param tree N + 1 entries in Fenwick form; no rebuild is done.
+         * @complexity O(N), a single copy.
+         */
+        void restore(std::span<const T> tree)
+        {
+            if (tree.empty())
+            {
+                throw std::invalid_argument("A Fenwick snapshot has at least one entry.");
+            }
+            m_tree.assign(tree.begin(), tree.end());
+            m_log_bit = std::bit_floor(size());
+        }
     };
-}
 
-/*
- * Range Update Point Query (RUPQ) Fenwick Tree
- * Operations: O(log m) range update(ui, uj, v) and O(log m) point query(i)
- * Operations: O(log m) range update(ui, uj, v) and O(log m) rsq(i, j)
- */
+    /*
+     * Range Update Point Query (RUPQ) Fenwick Tree
+     * Operations: O(log m) range_add(ui, uj, v) and O(log m) point_query(i)
+     */
 
-/*
-class RUPQ
-{
-private:
-   FenwickTree ft;
-
-public:
-   RUPQ(int m) : ft(FenwickTree(m)) {}
-   void range_update(int ui, int uj, int v)
-   {
-       ft.update(ui, v);
-       ft.update(uj + 1, -v);
-   }
-   long long point_query(int i) { return ft.rsq(i); }
-};
-// RUPQ variant
-// internalong longy use PURQ FT
-// [ui, ui+1, .., m] +v
-// [uj+1, uj+2, .., m] -v
-// [ui, ui+1, .., uj] +v
-// rsq(i) is sufficient
-class RURQ
-{
-   // RURQ variant
-private:
-   // needs two helper FTs
-   RUPQ rupq;
-   // one RUPQ and
-   FenwickTree purq;
-   // one PURQ
-public:
-   RURQ(int m) : rupq(RUPQ(m)), purq(FenwickTree(m)) {} // initialization
-   void range_update(int ui, int uj, int v)
-   {
-       rupq.range_update(ui, uj, v);
-       // [ui, ui+1, .., uj] +v
-       purq.update(ui, v * (ui - 1));
-       // -(ui-1)*v before ui
-       purq.update(uj + 1, -v * uj);
-       // +(uj-ui+1)*v after uj
-   }
-   long long rsq(int j)
-   {
-       return rupq.point_query(j) * j - purq.rsq(j);
-   }
-   long long rsq(int i, int j) { return rsq(j) - rsq(i - 1); } // standard
-};
+    // A range add over [ui, uj] becomes +v at ui and -v at uj + 1 in a
+    // difference array, whose prefix sum at i is the current value at i.
+
+    /**
+     * @brief A Fenwick Tree with range additions and point queries.
+     * @tparam T The numeric type of the elements.
+     *
+     * All indices are 1-based, like FenwickTree.
+     */
+    template <typename T>
+    class FenwickRUPQ
+    {
+    private:
+        FenwickTree<T> m_ft;
+
+    public:
+        /// @brief Constructs a tree of `size` zeros. O(N).
+        explicit FenwickRUPQ(size_t size) : m_ft(size) {}
+
+        /**
+         * @brief Adds v to every element in [ui, uj].
+         * @complexity O(log N)
+         */
+        void range_add(int ui, int uj, T v)
+        {
+            m_ft.add(ui, v);
+            m_ft.add(uj + 1, -v);
+        }
+
+        /**
+         * @brief Returns the current value at index i.
+         * @complexity O(log N)
+         */
+        T point_query(int i) const { return m_ft.query(i); }
+
+        size_t size() const { return m_ft.size(); }
+    };
+
+    /*
+     * Range Update Range Query (RURQ) Fenwick Tree
+     * Operations: O(log m) range_add(ui, uj, v) and O(log m) query_range(i, j)
+     */
+
+    // With B1 the RUPQ difference array and B2 a correction array, the prefix
+    // sum up to j is sum(B1[1..j]) * j - sum(B2[1..j]). A range add touches
+    // the same two indices in both arrays, so the pair is stored interleaved:
+    // every step of an update or query reads one 2 * sizeof(T) slot.
+
+    /**
+     * @brief A Fenwick Tree with range additions and range sum queries.
+     * @tparam T The numeric type of the elements.
+     *
+     * All indices are 1-based, like FenwickTree.
+     */
+    template <typename T>
+    class FenwickRURQ
+    {
+    private:
+        struct Slot
+        {
+            T b1, b2;
+        };
+
+        /// @brief Interleaved B1/B2 trees; index 0 is unused.
+        std::vector<Slot> m_tree;
+
+        void add(size_t i, T d1, T d2)
+        {
+            for (; i < m_tree.size(); i += i & (~i + 1))
+            {
+                m_tree[i].b1 += d1;
+                m_tree[i].b2 += d2;
+            }
+        }
+
+    public:
+        /// @brief Constructs a tree of `size` zeros. O(N).
+        explicit FenwickRURQ(size_t size) : m_tree(size + 1, Slot{T(0), T(0)}) {}
+
+        /**
+         * @brief Constructs a tree from a 0-indexed vector of initial values.
+         * @complexity O(N)
+         */
+        explicit FenwickRURQ(const std::vector<T> &values) : m_tree(values.size() + 1, Slot{T(0), T(0)})
+        {
+            // B1 = 0 and B2 = -values gives prefix(j) = sum(values[0..j)).
+            size_t n = values.size();
+            for (size_t i = 1; i <= n; ++i)
+            {
+                m_tree[i].b2 -= values[i - 1];
+                size_t parent = i + (i & (~i + 1));
+                if (parent <= n)
+                {
+                    m_tree[parent].b2 += m_tree[i].b2;
+                }
+            }
+        }
+
+        /**
+         * @brief Adds v to every element in [ui, uj].
+         * @complexity O(log N)
+         */
+        void range_add(int ui, int uj, T v)
+        {
+            add(ui, v, v * T(ui - 1));
+            add(uj + 1, -v, -v * T(uj));
+        }
+
+        /**
+         * @brief Calculates the prefix sum of [1, j].
+         * @complexity O(log N)
+         */
+        T query(int j) const
+        {
+            T s1 = T(0), s2 = T(0);
+            for (size_t k = j; k > 0; k -= k & (~k + 1))
+            {
+                s1 += m_tree[k].b1;
+                s2 += m_tree[k].b2;
+            }
+            return s1 * T(j) - s2;
+        }
+
+        /**
+         * @brief Calculates the sum of the range [i, j].
+         * @complexity O(log N)
+         */
+        T query_range(int i, int j) const
+        {
+            if (i > j)
+            {
+                return T(0);
+            }
+            return query(j) - query(i - 1);
+        }
+
+        /// @brief Returns the current value at index i. O(log N).
+        T point_query(int i) const { return query_range(i, i); }
+
+        size_t size() const { return m_tree.size() - 1; }
+    };
+}
 
 /*
 int main()
 {
-   vector<long long> f = {0, 0, 1, 0, 1, 2, 3, 2, 1, 1, 0}; // index 0 is always 0
+    std::vector<long long> f = {0, 1, 0, 1, 2, 3, 2, 1, 1, 0}; // 0-indexed values for indices 1..10
 
-   FenwickTree ft(f);
+    cp::FenwickTree<long long> ft(f);
 
-   printf("%long longd\n", ft.rsq(1, 6));  // 7 => ft[6]+ft[4] = 5+2 = 7
-   printf("%d\n", ft.select(7));    // index 6, rsq(1, 6) == 7, which is >= 7
-   ft.update(5, 1);                 // update demo
-   printf("%long longd\n", ft.rsq(1, 10)); // now 12
+    printf("%lld\n", ft.query_range(1, 6)); // 7
+    printf("%d\n", ft.find_kth(7));         // index 6, query(6) == 7, which is >= 7
+    ft.add(5, 1);                           // update demo
+    printf("%lld\n", ft.query(10));         // now 12
 
+    std::vector<std::pair<int, long long>> updates = {{2, 5}, {9, -1}};
+    ft.add_many(updates);
+    std::vector<int> at = {1, 10};
+    std::vector<long long> sums = ft.query_many(at); // {0, 16}
 
-   printf("=====\n");
-   RUPQ rupq(10);
-   RURQ rurq(10);
+    printf("=====\n");
+    cp::FenwickRUPQ<long long> rupq(10);
+    cp::FenwickRURQ<long long> rurq(10);
 
-   rupq.range_update(2, 9, 7); // indices in [2, 3, .., 9] updated by +7
-   rurq.range_update(2, 9, 7); // same as rupq above
-   rupq.range_update(6, 7, 3); // indices 6&7 are further updated by +3 (10)
-   rurq.range_update(6, 7, 3); // same as rupq above
+    rupq.range_add(2, 9, 7); // indices in [2, 3, .., 9] updated by +7
+    rurq.range_add(2, 9, 7); // same as rupq above
+    rupq.range_add(6, 7, 3); // indices 6&7 are further updated by +3 (10)
+    rurq.range_add(6, 7, 3); // same as rupq above
 
-   // idx = 0 (unused) | 1 | 2 | 3 | 4 | 5 | 6 | 7 | 8 | 9 |10
-   // val = - | 0 | 7 | 7 | 7 | 7 |10 |10 | 7 | 7 | 0
-   for (int i = 1; i <= 10; i++) {
-       printf("%d -> %long longd\n", i, rupq.point_query(i));
-   }
+    // idx = 0 (unused) | 1 | 2 | 3 | 4 | 5 | 6 | 7 | 8 | 9 |10
+    // val = - | 0 | 7 | 7 | 7 | 7 |10 |10 | 7 | 7 | 0
+    for (int i = 1; i <= 10; i++)
+    {
+        printf("%d -> %lld\n", i, rupq.point_query(i));
+    }
 
-   printf("RSQ(1, 10) = %long longd\n", rurq.rsq(1, 10)); // 62
-   printf("RSQ(6, 7) = %long longd\n", rurq.rsq(6, 7));   // 20
-   return 0;
+    printf("RSQ(1, 10) = %lld\n", rurq.query_range(1, 10)); // 62
+    printf("RSQ(6, 7) = %lld\n", rurq.query_range(6, 7));   // 20
+    return 0;
 }
-*/
\ No newline at end of file
+*/
@@ -0,0 +1,277 @@
+#pragma once
+/*
+ * 2D Fenwick Trees
+ * FenwickTree2D:        O(log R log C) add(x, y, v), query(x, y), query_range(x1, y1, x2, y2)
+ * OfflineFenwickTree2D: O(log^2 k) add and query over k points known in advance
+ */
+
+// FenwickTree2D keeps the (R + 1) x (C + 1) table in one row-major buffer, so
+// the inner loop over y walks a single contiguous row.
+//
+// OfflineFenwickTree2D is for sparse points with large coordinates. Every
+// update point is registered before build(). Each node of the Fenwick tree
+// over compressed x then keeps a sorted list of the y values that can reach
+// it, with an inner Fenwick tree over that list. All lists and inner trees
+// share two flat arrays (CSR layout), so memory is O(k log k).
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cassert>
+
+#include "coordinate_compressor.h"
+
+namespace cp
+{
+    /**
+     * @brief A 2D Fenwick Tree over an R x C grid for point updates and rectangle sums.
+     * @tparam T The numeric type of the elements.
+     *
+     * All coordinates are 1-based, like FenwickTree.
+     */
+    template <typename T>
+    class FenwickTree2D
+    {
+    private:
+        size_t m_rows, m_cols;
+        /// @brief Row-major (m_rows + 1) x (m_cols + 1); row 0 and column 0 are unused.
+        std::vector<T> m_tree;
+
+        static constexpr size_t lso(size_t i) { return i & (~i + 1); }
+
+    public:
+        /// @brief Constructs an R x C grid of zeros. O(R C).
+        FenwickTree2D(size_t rows, size_t cols)
+            : m_rows(rows), m_cols(cols), m_tree((rows + 1) * (cols + 1), T(0)) {}
+
+        /**
+         * @brief Adds delta to cell (x, y).
+         * @complexity O(log R log C)
+         */
+        void add(int x, int y, T delta)
+        {
+            for (size_t i = x; i <= m_rows; i += lso(i))
+            {
+                T *row = m_tree.data() + i * (m_cols + 1);
+                for (size_t j = y; j <= m_cols; j += lso(j))
+                {
+                    row[j] += delta;
+                }
+            }
+        }
+
+        /**
+         * @brief Calculates the sum of the rectangle [1, x] x [1, y].
+         * @complexity O(log R log C)
+         */
+        T query(int x, int y) const
+        {
+            T sum = T(0);
+            for (size_t i = x; i > 0; i -= lso(i))
+            {
+                const T *row = m_tree.data() + i * (m_cols + 1);
+                for (size_t j = y; j > 0; j -= lso(j))
+                {
+                    sum += row[j];
+                }
+            }
+            return sum;
+        }
+
+        /**
+         * @brief Calculates the sum of the rectangle [x1, x2] x [y1, y2].
+         * @complexity O(log R log C)
+         */
+        T query_range(int x1, int y1, int x2, int y2) const
+        {
+            if (x1 > x2 || y1 > y2)
+            {
+                return T(0);
+            }
+            return query(x2, y2) - query(x1 - 1, y2) - query(x2, y1 - 1) + query(x1 - 1, y1 - 1);
+        }
+
+        size_t rows() const { return m_rows; }
+        size_t cols() const { return m_cols; }
+    };
+
+    /**
+     * @brief A 2D Fenwick Tree over a fixed set of points with arbitrary coordinates.
+     * @tparam T The numeric type of the elements.
+     * @tparam Coord The coordinate type.
+     *
+     * Register every point that will be updated with add_point(), call build(),
+     * then add() and query() freely. Queries may use any coordinates.
+     */
+    template <typename T, typename Coord = long long>
+    class OfflineFenwickTree2D
+    {
+    private:
+        std::vector<std::pair<Coord, Coord>> m_points;
+        CoordinateCompressor<Coord> m_xs;
+        /// @brief Node i (1-based) owns m_ys[m_start[i - 1], m_start[i]) and the same range of m_tree.
+        std::vector<size_t> m_start;
+        std::vector<Coord> m_ys;
+        std::vector<T> m_tree;
+        bool m_built = false;
+
+        static constexpr size_t lso(size_t i) { return i & (~i + 1); }
+
+        size_t nodes() const { return m_start.size() - 1; }
+
+        /**
+         * @brief Sums the points whose x is among the first xcount compressed values
+         * and whose y is <= y (inclusive) or < y (otherwise).
+         */
+        T prefix(size_t xcount, const Coord &y, bool inclusive) const
+        {
+            assert(m_built);
+            T sum = T(0);
+            for (size_t i = xcount; i > 0; i -= lso(i))
+            {
+                const Coord *ys = m_ys.data() + m_start[i - 1];
+                size_t len = m_start[i] - m_start[i - 1];
+                const T *tree = m_tree.data() + m_start[i - 1];
+                size_t j = (inclusive ? std::upper_bound(ys, ys + len, y) : std::lower_bound(ys, ys + len, y)) - ys;
+                for (; j > 0; j -= lso(j))
+                {
+                    sum += tree[j - 1];
+                }
+            }
+            return sum;
+        }
+
+    public:
+        OfflineFenwickTree2D() = default;
+
+        /// @brief Registers a point that will receive updates. Must be called before build().
+        void add_point(Coord x, Coord y)
+        {
+            assert(!m_built);
+            m_points.emplace_back(x, y);
+        }
+
+        /**
+         * @brief Lays out the inner trees for the registered points.
+         * @complexity O(k log^2 k) for k points.
+         */
+        void build()
+        {
+            for (const auto &[x, y] : m_points)
+            {
+                m_xs.add(x);
+            }
+            m_xs.build();
+            size_t n = m_xs.size();
+
+            // Count, then fill, the y values reaching every node.
+            m_start.assign(n + 1, 0);
+            for (const auto &p : m_points)
+            {
+                for (size_t i = m_xs.index(p.first) + 1; i <= n; i += lso(i))
+                {
+                    ++m_start[i];
+                }
+            }
+            for (size_t i = 1; i <= n; ++i)
+            {
+                m_start[i] += m_start[i - 1];
+            }
+            m_ys.resize(m_start[n]);
+            std::vector<size_t> fill(m_start.begin(), m_start.end() - 1);
+            for (const auto &p : m_points)
+            {
+                for (size_t i = m_xs.index(p.first) + 1; i <= n; i += lso(i))
+                {
+                    m_ys[fill[i - 1]++] = p.second;
+                }
+            }
+
+            // Sort and deduplicate every node's list, compacting in place.
+            size_t write = 0;
+            for (size_t i = 1; i <= n; ++i)
+            {
+                auto first = m_ys.begin() + m_start[i - 1], last = m_ys.begin() + m_start[i];
+                std::sort(first, last);
+                last = std::unique(first, last);
+                m_start[i - 1] = write;
+                write = std::copy(first, last, m_ys.begin() + write) - m_ys.begin();
+            }
+            m_start[n] = write;
+            m_ys.resize(write);
+            m_ys.shrink_to_fit();
+            m_tree.assign(write, T(0));
+            m_points.clear();
+            m_points.shrink_to_fit();
+            m_built = true;
+        }
+
+        /**
+         * @brief Adds delta at the registered point (x, y).
+         * @complexity O(log^2 k)
+         */
+        void add(Coord x, Coord y, T delta)
+        {
+            assert(m_built);
+            for (size_t i = m_xs.index(x) + 1; i <= nodes(); i += lso(i))
+            {
+                const Coord *ys = m_ys.data() + m_start[i - 1];
+                size_t len = m_start[i] - m_start[i - 1];
+                T *tree = m_tree.data() + m_start[i - 1];
+                size_t j = std::lower_bound(ys, ys + len, y) - ys + 1;
+                assert(j <= len && ys[j - 1] == y);
+                for (; j <= len; j += lso(j))
+                {
+                    tree[j - 1] += delta;
+                }
+            }
+        }
+
+        /**
+         * @brief Calculates the sum over points with px <= x and py <= y.
+         * @complexity O(log^2 k)
+         */
+        T query(Coord x, Coord y) const
+        {
+            return prefix(m_xs.upper_bound(x), y, true);
+        }
+
+        /**
+         * @brief Calculates the sum over points in [x1, x2] x [y1, y2].
+         * @complexity O(log^2 k)
+         */
+        T query_range(Coord x1, Coord y1, Coord x2, Coord y2) const
+        {
+            if (x1 > x2 || y1 > y2)
+            {
+                return T(0);
+            }
+            // Exclude x < x1 and y < y1 by rank rather than through x1 - 1 and y1 - 1,
+            // which is wrong for floating-point Coord and overflows at its minimum.
+            size_t hi = m_xs.upper_bound(x2), lo = m_xs.lower_bound(x1);
+            return prefix(hi, y2, true) - prefix(lo, y2, true) - prefix(hi, y1, false) + prefix(lo, y1, false);
+        }
+    };
+}
+
+/*
+int main()
+{
+    cp::FenwickTree2D<long long> grid(4, 5);
+    grid.add(1, 1, 3);
+    grid.add(2, 3, 4);
+    grid.add(4, 5, 5);
+    printf("%lld %lld\n", grid.query(2, 3), grid.query_range(2, 2, 4, 5)); // 7 9
+
+    cp::OfflineFenwickTree2D<int> pts;
+    pts.add_point(1000000000, 7);
+    pts.add_point(-3, 7);
+    pts.add_point(5, -20);
+    pts.build();
+    pts.add(1000000000, 7, 1);
+    pts.add(-3, 7, 2);
+    pts.add(5, -20, 4);
+    printf("%d %d\n", pts.query(5, 7), pts.query_range(0, -100, 2000000000, 100)); // 6 5
+    return 0;
+}
+*/
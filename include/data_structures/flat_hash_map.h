@@ -0,0 +1,356 @@
+#pragma once
+/*
+ * Flat open-addressing hash map (Robin Hood hashing)
+ * Operation: O(1) expected operator[](key), find(key), contains(key)
+ * Operation: O(1) expected erase(key) with backward-shift deletion
+ * Operation: O(capacity) iteration over contiguous arrays
+ */
+
+// Keys, values and one probe-distance byte per slot live in three separate
+// contiguous arrays (structure of arrays): probing scans the 1-byte distance
+// array and only touches a key on a distance match, iteration is a linear
+// sweep, and no node is ever allocated per insert. Robin Hood insertion keeps
+// probe sequences short at high load, and lookups stop as soon as they meet a
+// slot whose entry is closer to its home than the probe is.
+//
+// Unlike HashTable (hash_table.h), this does not depend on libstdc++'s pb_ds,
+// has an explicit reserve(), and a configurable max_load_factor(). Hashing
+// defaults to chash (splitmix64 with a per-run random seed).
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <functional>
+#include <stdexcept>
+#include <iterator>
+#include <type_traits>
+#include <bit>
+
+#include "chash.h"
+#include "../debug/stats.h"
+
+namespace cp
+{
+    /**
+     * @brief An open-addressing hash map with Robin Hood probing.
+     * @tparam K The key type. Must be default constructible.
+     * @tparam V The mapped type. Must be default constructible.
+     * @tparam Hash The hash function, chash by default.
+     * @tparam KeyEqual The key equality predicate.
+     *
+     * Inserting or erasing invalidates iterators and references.
+     */
+    template <typename K, typename V, typename Hash = chash, typename KeyEqual = std::equal_to<K>>
+    class FlatHashMap
+    {
+    private:
+        static constexpr std::uint8_t EMPTY = 0;
+        static constexpr std::uint8_t MAX_DIST = 255;
+
+        std::vector<K> m_keys;
+        std::vector<V> m_values;
+        /// @brief 0 for an empty slot, otherwise 1 + distance from the key's home slot.
+        std::vector<std::uint8_t> m_dist;
+        size_t m_size = 0, m_mask = 0;
+        int m_shift = 64;
+        /// @brief Mixed into the hash before choosing a slot; changes with the capacity (see home()).
+        std::uint64_t m_salt = 0;
+        float m_max_load = 0.8f;
+        Hash m_hash;
+        KeyEqual m_eq;
+
+        /**
+         * @brief The top bits of the folded 128-bit product (h ^ salt) * 2^64 / phi.
+         *
+         * The fold spreads weak hashes such as std::hash<int>. Because the salt
+         * depends on the capacity, tables of different sizes order keys
+         * unrelatedly: copying a large map into a smaller one in iteration order
+         * does not pile every key into one run.
+         */
+        size_t home(const K &key) const
+        {
+            __uint128_t p = static_cast<__uint128_t>(static_cast<std::uint64_t>(m_hash(key)) ^ m_salt) * 0x9e3779b97f4a7c15ULL;
+            return static_cast<size_t>((static_cast<std::uint64_t>(p) ^ static_cast<std::uint64_t>(p >> 64)) >> m_shift);
+        }
+        size_t capacity() const { return m_dist.size(); }
+
+        size_t find_index(const K &key) const
+        {
+            if (m_size == 0)
+                return capacity();
+            size_t i = home(key);
+            for (std::uint8_t d = 1;; ++d, i = (i + 1) & m_mask)
+            {
+                if (m_dist[i] < d)
+                {
+                    CP_STAT("FlatHashMap probe", d);
+                    return capacity();
+                }
+                if (m_dist[i] == d && m_eq(m_keys[i], key))
+                {
+                    CP_STAT("FlatHashMap probe", d);
+                    return i;
+                }
+            }
+        }
+
+        void rehash(size_t new_capacity)
+        {
+            std::vector<K> keys(new_capacity);
+            std::vector<V> values(new_capacity);
+            std::vector<std::uint8_t> dist(new_capacity, EMPTY);
+            keys.swap(m_keys), values.swap(m_values), dist.swap(m_dist);
+            m_mask = new_capacity - 1;
+            m_shift = 64 - std::countr_zero(new_capacity);
+            m_salt = chash::splitmix64(new_capacity);
+            m_size = 0;
+            for (size_t i = 0; i < dist.size(); ++i)
+                if (dist[i] != EMPTY)
+                    insert_new(std::move(keys[i]), std::move(values[i]));
+        }
+
+        void grow()
+        {
+            rehash(capacity() == 0 ? 16 : 2 * capacity());
+        }
+
+        /**
+         * @brief Inserts a key known to be absent.
+         * @return The slot where the new key ended up.
+         */
+        size_t insert_new(K key, V value)
+        {
+            if (static_cast<float>(m_size + 1) > m_max_load * static_cast<float>(capacity()))
+                grow();
+
+            size_t i = home(key), result = capacity();
+            std::uint8_t d = 1;
+            while (true)
+            {
+                if (m_dist[i] == EMPTY)
+                {
+                    m_keys[i] = std::move(key), m_values[i] = std::move(value), m_dist[i] = d;
+                    ++m_size;
+                    return result == capacity() ? i : result;
+                }
+                if (m_dist[i] < d)
+                {
+                    // Robin Hood: the richer resident gives up its slot.
+                    std::swap(key, m_keys[i]), std::swap(value, m_values[i]), std::swap(d, m_dist[i]);
+                    if (result == capacity())
+                        result = i;
+                }
+                i = (i + 1) & m_mask;
+                if (++d == MAX_DIST)
+                {
+                    // Heavy clustering: grow, then place the entry in hand again. A
+                    // sparse table that still overflows means the hash itself is degenerate.
+                    if (m_size * 8 < capacity())
+                        throw std::overflow_error("FlatHashMap: probe distance overflow, the hash clusters too much.");
+                    bool displaced = result != capacity();
+                    K placed = displaced ? m_keys[result] : K();
+                    grow();
+                    size_t j = insert_new(std::move(key), std::move(value));
+                    return displaced ? find_index(placed) : j;
+                }
+            }
+        }
+
+    public:
+        using key_type = K;
+        using mapped_type = V;
+
+        /// @brief Forward iterator yielding std::pair<const K &, V &>.
+        template <bool Const>
+        class Iterator
+        {
+            using Map = std::conditional_t<Const, const FlatHashMap, FlatHashMap>;
+            using Ref = std::pair<const K &, std::conditional_t<Const, const V &, V &>>;
+
+            Map *m_map;
+            size_t m_pos;
+
+            void skip()
+            {
+                while (m_pos < m_map->capacity() && m_map->m_dist[m_pos] == EMPTY)
+                    ++m_pos;
+            }
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Ref;
+            using difference_type = std::ptrdiff_t;
+            using reference = Ref;
+
+            struct Arrow
+            {
+                Ref ref;
+                const Ref *operator->() const { return &ref; }
+            };
+
+            Iterator(Map *map, size_t pos) : m_map(map), m_pos(pos) { skip(); }
+
+            Ref operator*() const { return {m_map->m_keys[m_pos], m_map->m_values[m_pos]}; }
+            Arrow operator->() const { return {**this}; }
+            Iterator &operator++()
+            {
+                ++m_pos;
+                skip();
+                return *this;
+            }
+            Iterator operator++(int)
+            {
+                Iterator old = *this;
+                ++*this;
+                return old;
+            }
+            bool operator==(const Iterator &other) const { return m_pos == other.m_pos; }
+            bool operator!=(const Iterator &other) const { return m_pos != other.m_pos; }
+
+            friend class FlatHashMap;
+        };
+
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        FlatHashMap() = default;
+
+        /// @brief Constructs an empty map with room for `count` elements.
+        explicit FlatHashMap(size_t count) { reserve(count); }
+
+        /**
+         * @brief Makes room for `count` elements without further rehashing.
+         * @complexity O(capacity)
+         */
+        void reserve(size_t count)
+        {
+            size_t needed = static_cast<size_t>(static_cast<float>(count) / m_max_load) + 1, cap = 16;
+            while (cap < needed)
+                cap <<= 1;
+            if (cap > capacity())
+                rehash(cap);
+        }
+
+        /// @brief Returns the maximum load factor.
+        float max_load_factor() const { return m_max_load; }
+
+        /// @brief Sets the maximum load factor, in (0, 1). Rehashes if needed.
+        void max_load_factor(float f)
+        {
+            if (!(f > 0.0f && f < 1.0f))
+                throw std::invalid_argument("max_load_factor must be in (0, 1).");
+            m_max_load = f;
+            reserve(m_size);
+        }
+
+        /// @brief Returns the current load factor.
+        float load_factor() const { return capacity() == 0 ? 0.0f : static_cast<float>(m_size) / capacity(); }
+
+        /// @brief Returns a reference to the value for `key`, inserting V() if absent.
+        V &operator[](const K &key)
+        {
+            size_t i = find_index(key);
+            if (i == capacity())
+                i = insert_new(key, V());
+            return m_values[i];
+        }
+
+        /// @brief Returns the value for `key`; throws std::out_of_range if absent.
+        V &at(const K &key)
+        {
+            size_t i = find_index(key);
+            if (i == capacity())
+                throw std::out_of_range("FlatHashMap::at: key not found.");
+            return m_values[i];
+        }
+
+        const V &at(const K &key) const
+        {
+            size_t i = find_index(key);
+            if (i == capacity())
+                throw std::out_of_range("FlatHashMap::at: key not found.");
+            return m_values[i];
+        }
+
+        /**
+         * @brief Inserts (key, value) if key is absent.
+         * @return An iterator to the element and whether an insertion took place.
+         */
+        std::pair<iterator, bool> insert(const K &key, const V &value)
+        {
+            size_t i = find_index(key);
+            if (i != capacity())
+                return {iterator(this, i), false};
+            return {iterator(this, insert_new(key, value)), true};
+        }
+
+        iterator find(const K &key) { return iterator(this, find_index(key)); }
+        const_iterator find(const K &key) const { return const_iterator(this, find_index(key)); }
+        bool contains(const K &key) const { return find_index(key) != capacity(); }
+        size_t count(const K &key) const { return contains(key) ? 1 : 0; }
+
+        /**
+         * @brief Removes `key` using backward-shift deletion (no tombstones).
+         * @return The number of removed elements (0 or 1).
+         */
+        size_t erase(const K &key)
+        {
+            size_t i = find_index(key);
+            if (i == capacity())
+                return 0;
+            while (true)
+            {
+                size_t next = (i + 1) & m_mask;
+                if (m_dist[next] <= 1)
+                {
+                    m_keys[i] = K(), m_values[i] = V(), m_dist[i] = EMPTY;
+                    break;
+                }
+                m_keys[i] = std::move(m_keys[next]), m_values[i] = std::move(m_values[next]);
+                m_dist[i] = m_dist[next] - 1;
+                i = next;
+            }
+            --m_size;
+            return 1;
+        }
+
+        /// @brief Removes every element, keeping the capacity.
+        void clear()
+        {
+            for (size_t i = 0; i < capacity(); ++i)
+                if (m_dist[i] != EMPTY)
+                    m_keys[i] = K(), m_values[i] = V(), m_dist[i] = EMPTY;
+            m_size = 0;
+        }
+
+        size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+
+        iterator begin() { return iterator(this, 0); }
+        iterator end() { return iterator(this, capacity()); }
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, capacity()); }
+    };
+}
+
+/*
+int main()
+{
+    cp::FlatHashMap<int, int> mp;
+    mp.reserve(1 << 20); // no rehash for the first ~800k inserts
+
+    mp[1]++;
+    mp[2]++;
+    mp[1]++;
+
+    printf("%d %d %d\n", mp[1], mp[2], (int)mp.contains(5)); // 2 1 0
+
+    mp.erase(2);
+    for (auto [val, freq] : mp)
+    {
+        printf("%d %d\n", val, freq); // 1 2
+    }
+    return 0;
+}
+*/
@@ -2,26 +2,77 @@
 
 #include <ext/pb_ds/assoc_container.hpp>
 
-struct chash
+#include "chash.h"
+#include "../debug/stats.h"
+
+#ifdef CP_INSTRUMENT
+// "HashTable probe": one event per hash computation (a lookup, an insert or a
+// key moved by a rehash), valued by the keys compared until gp_hash_table
+// settled on a slot. gp_hash_table has no end-of-lookup hook, so a lookup's
+// count is recorded when the next hash on the same thread starts one, and the
+// last at thread exit.
+struct hash_table_probe
+{
+    std::uint64_t compared = 0;
+    bool open = false;
+
+    void record()
+    {
+        if (open)
+            CP_STAT("HashTable probe", compared);
+        compared = 0;
+    }
+
+    ~hash_table_probe() { record(); }
+
+    static hash_table_probe &current()
+    {
+        thread_local hash_table_probe probe;
+        return probe;
+    }
+};
+
+struct hash_table_chash : chash
 {
-    static uint64_t splitmix64(uint64_t x)
+    template <typename T>
+    size_t operator()(const T &x) const
     {
-        // http://xorshift.di.unimi.it/splitmix64.c
-        x += 0x9e3779b97f4a7c15;
-        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
-        x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
-        return x ^ (x >> 31);
+        hash_table_probe &probe = hash_table_probe::current();
+        probe.record();
+        probe.open = true;
+        return chash::operator()(x);
     }
+};
 
-    size_t operator()(uint64_t x) const
+template <typename U>
+struct hash_table_eq
+{
+    bool operator()(const U &a, const U &b) const
     {
-        static const uint64_t FIXED_RANDOM = std::chrono::steady_clock::now().time_since_epoch().count();
-        return splitmix64(x + FIXED_RANDOM);
+        ++hash_table_probe::current().compared;
+        return a == b;
     }
 };
+#else
+using hash_table_chash = chash;
+
+template <typename U>
+using hash_table_eq = typename __gnu_pbds::detail::default_eq_fn<U>::type;
+#endif
 
-template <typename U, typename V>
-using HashTable = __gnu_pbds::gp_hash_table<U, V, chash>;
+// Alloc may be cp::ArenaAllocator<char> (memory/arena.h); the other policies
+// are gp_hash_table's defaults, spelled out only to reach the last parameter.
+template <typename U, typename V, typename Alloc = std::allocator<char>>
+using HashTable = __gnu_pbds::gp_hash_table<
+    U,
+    V,
+    hash_table_chash,
+    hash_table_eq<U>,
+    __gnu_pbds::detail::default_comb_hash_fn::type,
+    typename __gnu_pbds::detail::default_probe_fn<__gnu_pbds::detail::default_comb_hash_fn::type>::type,
+    typename __gnu_pbds::detail::default_resize_policy<__gnu_pbds::detail::default_comb_hash_fn::type>::type,
+    __gnu_pbds::detail::default_store_hash,
+    Alloc>;
 
 /*
 int main()
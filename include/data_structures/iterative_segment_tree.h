@@ -0,0 +1,202 @@
+#pragma once
+/*
+ * Iterative (bottom-up) Segment Tree over a monoid
+ * Operation: O(n) build from an Array A
+ * Operation: O(log n) prod(l, r) over the half-open range [l, r)
+ * Operation: O(log n) Point update set(p, v)
+ * Operation: O(log n) max_right(l, f) / min_left(r, f) binary search
+ */
+
+// Unlike SegmentTree (segment_tree.h), which is fixed to int RMQ, this tree is
+// generic over a monoid policy (see monoid.h), uses no recursion and stores
+// 2 * bit_ceil(n) nodes: leaves at [size, 2 * size), node p has children 2p, 2p + 1.
+
+#include <vector>
+#include <bit>
+#include <cassert>
+
+#include "monoid.h"
+
+namespace cp
+{
+    /**
+     * @brief A non-recursive segment tree over an arbitrary monoid.
+     * @tparam Monoid A policy with `value_type`, `identity()` and `combine(a, b)`.
+     *
+     * `combine` need not be commutative: products are always taken left to right.
+     * All indices are 0-based and ranges are half-open.
+     */
+    template <typename Monoid>
+    class SegTree
+    {
+    public:
+        using T = typename Monoid::value_type;
+
+    private:
+        int m_n = 0, m_size = 1;
+        /// @brief Node storage. m_tree[1] is the root, m_tree[m_size + i] is leaf i.
+        std::vector<T> m_tree;
+
+        void pull(int p)
+        {
+            m_tree[p] = Monoid::combine(m_tree[2 * p], m_tree[2 * p + 1]);
+        }
+
+    public:
+        /**
+         * @brief Constructs a tree of n identity elements.
+         * @complexity O(n)
+         */
+        explicit SegTree(int n = 0) : SegTree(std::vector<T>(n, Monoid::identity())) {}
+
+        /**
+         * @brief Constructs a tree from an initial list of values.
+         * @param values A 0-indexed vector of initial values.
+         * @complexity O(n)
+         */
+        explicit SegTree(const std::vector<T> &values)
+            : m_n(static_cast<int>(values.size())),
+              m_size(static_cast<int>(std::bit_ceil(values.size() | 1))),
+              m_tree(2 * m_size, Monoid::identity())
+        {
+            for (int i = 0; i < m_n; ++i)
+                m_tree[m_size + i] = values[i];
+            for (int p = m_size - 1; p >= 1; --p)
+                pull(p);
+        }
+
+        /**
+         * @brief Replaces the element at index p.
+         * @complexity O(log n)
+         */
+        void set(int p, const T &value)
+        {
+            assert(0 <= p && p < m_n);
+            p += m_size;
+            m_tree[p] = value;
+            for (p >>= 1; p >= 1; p >>= 1)
+                pull(p);
+        }
+
+        /// @brief Returns the element at index p. O(1).
+        const T &get(int p) const
+        {
+            assert(0 <= p && p < m_n);
+            return m_tree[m_size + p];
+        }
+
+        /**
+         * @brief Combines the elements in [l, r), or returns the identity if l == r.
+         * @complexity O(log n)
+         */
+        T prod(int l, int r) const
+        {
+            assert(0 <= l && l <= r && r <= m_n);
+            T left = Monoid::identity(), right = Monoid::identity();
+            for (l += m_size, r += m_size; l < r; l >>= 1, r >>= 1)
+            {
+                if (l & 1)
+                    left = Monoid::combine(left, m_tree[l++]);
+                if (r & 1)
+                    right = Monoid::combine(m_tree[--r], right);
+            }
+            return Monoid::combine(left, right);
+        }
+
+        /// @brief Combines all elements. O(1).
+        const T &all_prod() const { return m_tree[1]; }
+
+        /**
+         * @brief Finds the largest r such that f(prod(l, r)) is true.
+         * @param f A predicate that is monotone (true then false) as r grows,
+         *          with f(identity()) == true.
+         * @complexity O(log n)
+         */
+        template <typename F>
+        int max_right(int l, F f) const
+        {
+            assert(0 <= l && l <= m_n && f(Monoid::identity()));
+            if (l == m_n)
+                return m_n;
+            l += m_size;
+            T acc = Monoid::identity();
+            do
+            {
+                while (l % 2 == 0)
+                    l >>= 1;
+                if (!f(Monoid::combine(acc, m_tree[l])))
+                {
+                    while (l < m_size)
+                    {
+                        l = 2 * l;
+                        if (f(Monoid::combine(acc, m_tree[l])))
+                            acc = Monoid::combine(acc, m_tree[l++]);
+                    }
+                    return l - m_size;
+                }
+                acc = Monoid::combine(acc, m_tree[l++]);
+            } while ((l & -l) != l);
+            return m_n;
+        }
+
+        /**
+         * @brief Finds the smallest l such that f(prod(l, r)) is true.
+         * @param f A predicate that is monotone (true then false) as l shrinks,
+         *          with f(identity()) == true.
+         * @complexity O(log n)
+         */
+        template <typename F>
+        int min_left(int r, F f) const
+        {
+            assert(0 <= r && r <= m_n && f(Monoid::identity()));
+            if (r == 0)
+                return 0;
+            r += m_size;
+            T acc = Monoid::identity();
+            do
+            {
+                --r;
+                while (r > 1 && (r % 2))
+                    r >>= 1;
+                if (!f(Monoid::combine(m_tree[r], acc)))
+                {
+                    while (r < m_size)
+                    {
+                        r = 2 * r + 1;
+                        if (f(Monoid::combine(m_tree[r], acc)))
+                            acc = Monoid::combine(m_tree[r--], acc);
+                    }
+                    return r + 1 - m_size;
+                }
+                acc = Monoid::combine(m_tree[r], acc);
+            } while ((r & -r) != r);
+            return 0;
+        }
+
+        /// @brief Returns the number of elements (n).
+        int size() const { return m_n; }
+    };
+}
+
+/*
+int main()
+{
+    std::vector<int> A = {18, 17, 13, 19, 15, 11, 20, 99};
+    cp::SegTree<cp::monoid::Min<int>> st(A);
+
+    printf("prod(1, 4) = %d\n", st.prod(1, 4)); // min of A[1..3] = 13
+    printf("prod(4, 8) = %d\n", st.prod(4, 8)); // min of A[4..7] = 11
+
+    st.set(5, 77);                              // A = {18,17,13,19,15,77,20,99}
+    printf("prod(4, 8) = %d\n", st.prod(4, 8)); // now 15
+
+    // Sums over a prefix: largest r with A[0] + ... + A[r - 1] <= 50
+    cp::SegTree<cp::monoid::Sum<long long>> sum(std::vector<long long>(A.begin(), A.end()));
+    printf("max_right = %d\n", sum.max_right(0, [](long long s) { return s <= 50; })); // 3 (18+17+13 = 48)
+
+    // Negative values work too: no sentinel value is reserved
+    cp::SegTree<cp::monoid::Max<int>> mx(std::vector<int>{-5, -1, -7});
+    printf("max = %d\n", mx.all_prod()); // -1
+    return 0;
+}
+*/
@@ -0,0 +1,395 @@
+#pragma once
+/*
+ * Iterative Lazy Segment Tree with pluggable tag algebra
+ * Operation: O(n) build from an Array A
+ * Operation: O(log n) prod(l, r) over the half-open range [l, r)
+ * Operation: O(log n) Range update apply(l, r, f)
+ * Operation: O(log n) Point update set(p, v)
+ * Operation: O(log n) max_right(l, f) / min_left(r, f) binary search
+ */
+
+// Pushes happen top-down only along the two boundary paths of a query, and
+// pulls bottom-up along the same paths, so untouched subtrees are never
+// visited. The tree is a power-of-two array: node p has children 2p, 2p + 1.
+//
+// An Action policy describes the lazy tags:
+//   using tag_type = F;
+//   static constexpr F identity();                           // no-op tag
+//   static constexpr F compose(const F &f, const F &g);      // apply g, then f
+//   static constexpr T apply(const F &f, const T &x, int len); // tag on a node covering len leaves
+
+#include <vector>
+#include <bit>
+#include <optional>
+#include <utility>
+#include <limits>
+#include <algorithm>
+#include <cassert>
+
+#include "monoid.h"
+#include "../debug/stats.h"
+
+namespace cp
+{
+    namespace action
+    {
+        /// @brief Range add for Min/Max monoids: x -> x + f.
+        template <typename T>
+        struct Add
+        {
+            using tag_type = T;
+            static constexpr T identity() { return T(0); }
+            static constexpr T compose(const T &f, const T &g) { return f + g; }
+            static constexpr T apply(const T &f, const T &x, int) { return x + f; }
+        };
+
+        /// @brief Range add for the Sum monoid: each of the len elements gains f.
+        template <typename T>
+        struct AddSum
+        {
+            using tag_type = T;
+            static constexpr T identity() { return T(0); }
+            static constexpr T compose(const T &f, const T &g) { return f + g; }
+            static constexpr T apply(const T &f, const T &x, int len) { return x + f * T(len); }
+        };
+
+        /// @brief Range assign for Min/Max monoids: x -> f.
+        template <typename T>
+        struct Assign
+        {
+            using tag_type = std::optional<T>;
+            static constexpr tag_type identity() { return std::nullopt; }
+            static constexpr tag_type compose(const tag_type &f, const tag_type &g) { return f ? f : g; }
+            static constexpr T apply(const tag_type &f, const T &x, int) { return f ? *f : x; }
+        };
+
+        /// @brief Range assign for the Sum monoid: the node sum becomes f * len.
+        template <typename T>
+        struct AssignSum
+        {
+            using tag_type = std::optional<T>;
+            static constexpr tag_type identity() { return std::nullopt; }
+            static constexpr tag_type compose(const tag_type &f, const tag_type &g) { return f ? f : g; }
+            static constexpr T apply(const tag_type &f, const T &x, int len) { return f ? *f * T(len) : x; }
+        };
+
+        /**
+         * @brief Range affine map x -> a * x + b for the Sum monoid.
+         *
+         * Typically used with T = cp::Zn<MOD>; the tag (a, b) is stored as a pair.
+         */
+        template <typename T>
+        struct AffineSum
+        {
+            using tag_type = std::pair<T, T>;
+            static constexpr tag_type identity() { return {T(1), T(0)}; }
+            static constexpr tag_type compose(const tag_type &f, const tag_type &g)
+            {
+                return {f.first * g.first, f.first * g.second + f.second};
+            }
+            static constexpr T apply(const tag_type &f, const T &x, int len) { return f.first * x + f.second * T(len); }
+        };
+
+        /// @brief Range chmin x -> min(x, f), valid for both Min and Max monoids.
+        template <typename T>
+        struct Chmin
+        {
+            using tag_type = T;
+            static constexpr T identity() { return std::numeric_limits<T>::max(); }
+            static constexpr T compose(const T &f, const T &g) { return std::min(f, g); }
+            static constexpr T apply(const T &f, const T &x, int) { return std::min(x, f); }
+        };
+
+        /// @brief Range chmax x -> max(x, f), valid for both Min and Max monoids.
+        template <typename T>
+        struct Chmax
+        {
+            using tag_type = T;
+            static constexpr T identity() { return std::numeric_limits<T>::lowest(); }
+            static constexpr T compose(const T &f, const T &g) { return std::max(f, g); }
+            static constexpr T apply(const T &f, const T &x, int) { return std::max(x, f); }
+        };
+    }
+
+    /**
+     * @brief A non-recursive lazy segment tree.
+     * @tparam Monoid The value monoid (see monoid.h).
+     * @tparam Action The tag algebra acting on Monoid values (see cp::action).
+     *
+     * All indices are 0-based and ranges are half-open.
+     */
+    template <typename Monoid, typename Action>
+    class LazySegTree
+    {
+    public:
+        using T = typename Monoid::value_type;
+        using F = typename Action::tag_type;
+
+    private:
+        int m_n = 0, m_size = 1, m_log = 0;
+        std::vector<T> m_tree;
+        std::vector<F> m_lazy;
+
+        void pull(int p)
+        {
+            m_tree[p] = Monoid::combine(m_tree[2 * p], m_tree[2 * p + 1]);
+        }
+
+        /// @brief Number of leaves under node p.
+        int length(int p) const
+        {
+            return m_size >> (std::bit_width(static_cast<unsigned>(p)) - 1);
+        }
+
+        void apply_node(int p, const F &f)
+        {
+            m_tree[p] = Action::apply(f, m_tree[p], length(p));
+            if (p < m_size)
+                m_lazy[p] = Action::compose(f, m_lazy[p]);
+        }
+
+        void push(int p)
+        {
+            CP_STAT("LazySegTree push", 1);
+            apply_node(2 * p, m_lazy[p]);
+            apply_node(2 * p + 1, m_lazy[p]);
+            m_lazy[p] = Action::identity();
+        }
+
+        /// @brief Pushes every pending tag on the root-to-leaf paths of the boundaries l and r.
+        void push_boundaries(int l, int r)
+        {
+            for (int i = m_log; i >= 1; --i)
+            {
+                if (((l >> i) << i) != l)
+                    push(l >> i);
+                if (((r >> i) << i) != r)
+                    push((r - 1) >> i);
+            }
+        }
+
+    public:
+        /**
+         * @brief Constructs a tree of n identity elements.
+         * @complexity O(n)
+         */
+        explicit LazySegTree(int n = 0) : LazySegTree(std::vector<T>(n, Monoid::identity())) {}
+
+        /**
+         * @brief Constructs a tree from an initial list of values.
+         * @param values A 0-indexed vector of initial values.
+         * @complexity O(n)
+         */
+        explicit LazySegTree(const std::vector<T> &values)
+            : m_n(static_cast<int>(values.size())),
+              m_size(static_cast<int>(std::bit_ceil(values.size() | 1))),
+              m_log(std::countr_zero(static_cast<unsigned>(m_size))),
+              m_tree(2 * m_size, Monoid::identity()),
+              m_lazy(m_size, Action::identity())
+        {
+            for (int i = 0; i < m_n; ++i)
+                m_tree[m_size + i] = values[i];
+            for (int p = m_size - 1; p >= 1; --p)
+                pull(p);
+        }
+
+        /**
+         * @brief Replaces the element at index p.
+         * @complexity O(log n)
+         */
+        void set(int p, const T &value)
+        {
+            assert(0 <= p && p < m_n);
+            p += m_size;
+            for (int i = m_log; i >= 1; --i)
+                push(p >> i);
+            m_tree[p] = value;
+            for (int i = 1; i <= m_log; ++i)
+                pull(p >> i);
+        }
+
+        /**
+         * @brief Returns the element at index p.
+         * @complexity O(log n)
+         */
+        T get(int p)
+        {
+            assert(0 <= p && p < m_n);
+            p += m_size;
+            for (int i = m_log; i >= 1; --i)
+                push(p >> i);
+            return m_tree[p];
+        }
+
+        /**
+         * @brief Combines the elements in [l, r), or returns the identity if l == r.
+         * @complexity O(log n)
+         */
+        T prod(int l, int r)
+        {
+            assert(0 <= l && l <= r && r <= m_n);
+            if (l == r)
+                return Monoid::identity();
+            l += m_size, r += m_size;
+            push_boundaries(l, r);
+
+            T left = Monoid::identity(), right = Monoid::identity();
+            for (; l < r; l >>= 1, r >>= 1)
+            {
+                if (l & 1)
+                    left = Monoid::combine(left, m_tree[l++]);
+                if (r & 1)
+                    right = Monoid::combine(m_tree[--r], right);
+            }
+            return Monoid::combine(left, right);
+        }
+
+        /// @brief Combines all elements. O(1).
+        const T &all_prod() const { return m_tree[1]; }
+
+        /**
+         * @brief Applies tag f to the element at index p.
+         * @complexity O(log n)
+         */
+        void apply(int p, const F &f)
+        {
+            assert(0 <= p && p < m_n);
+            p += m_size;
+            for (int i = m_log; i >= 1; --i)
+                push(p >> i);
+            m_tree[p] = Action::apply(f, m_tree[p], 1);
+            for (int i = 1; i <= m_log; ++i)
+                pull(p >> i);
+        }
+
+        /**
+         * @brief Applies tag f to every element in [l, r).
+         * @complexity O(log n)
+         */
+        void apply(int l, int r, const F &f)
+        {
+            assert(0 <= l && l <= r && r <= m_n);
+            if (l == r)
+                return;
+            l += m_size, r += m_size;
+            push_boundaries(l, r);
+
+            for (int a = l, b = r; a < b; a >>= 1, b >>= 1)
+            {
+                if (a & 1)
+                    apply_node(a++, f);
+                if (b & 1)
+                    apply_node(--b, f);
+            }
+
+            for (int i = 1; i <= m_log; ++i)
+            {
+                if (((l >> i) << i) != l)
+                    pull(l >> i);
+                if (((r >> i) << i) != r)
+                    pull((r - 1) >> i);
+            }
+        }
+
+        /**
+         * @brief Finds the largest r such that g(prod(l, r)) is true.
+         * @param g A predicate that is monotone (true then false) as r grows,
+         *          with g(identity()) == true.
+         * @complexity O(log n)
+         */
+        template <typename G>
+        int max_right(int l, G g)
+        {
+            assert(0 <= l && l <= m_n && g(Monoid::identity()));
+            if (l == m_n)
+                return m_n;
+            l += m_size;
+            for (int i = m_log; i >= 1; --i)
+                push(l >> i);
+            T acc = Monoid::identity();
+            do
+            {
+                while (l % 2 == 0)
+                    l >>= 1;
+                if (!g(Monoid::combine(acc, m_tree[l])))
+                {
+                    while (l < m_size)
+                    {
+                        push(l);
+                        l = 2 * l;
+                        if (g(Monoid::combine(acc, m_tree[l])))
+                            acc = Monoid::combine(acc, m_tree[l++]);
+                    }
+                    return l - m_size;
+                }
+                acc = Monoid::combine(acc, m_tree[l++]);
+            } while ((l & -l) != l);
+            return m_n;
+        }
+
+        /**
+         * @brief Finds the smallest l such that g(prod(l, r)) is true.
+         * @param g A predicate that is monotone (true then false) as l shrinks,
+         *          with g(identity()) == true.
+         * @complexity O(log n)
+         */
+        template <typename G>
+        int min_left(int r, G g)
+        {
+            assert(0 <= r && r <= m_n && g(Monoid::identity()));
+            if (r == 0)
+                return 0;
+            r += m_size;
+            for (int i = m_log; i >= 1; --i)
+                push((r - 1) >> i);
+            T acc = Monoid::identity();
+            do
+            {
+                --r;
+                while (r > 1 && (r % 2))
+                    r >>= 1;
+                if (!g(Monoid::combine(m_tree[r], acc)))
+                {
+                    while (r < m_size)
+                    {
+                        push(r);
+                        r = 2 * r + 1;
+                        if (g(Monoid::combine(m_tree[r], acc)))
+                            acc = Monoid::combine(m_tree[r--], acc);
+                    }
+                    return r + 1 - m_size;
+                }
+                acc = Monoid::combine(m_tree[r], acc);
+            } while ((r & -r) != r);
+            return 0;
+        }
+
+        /// @brief Returns the number of elements (n).
+        int size() const { return m_n; }
+    };
+}
+
+/*
+int main()
+{
+    // Range assign + range min, the drop-in replacement for SegmentTree
+    std::vector<int> A = {18, 17, 13, 19, 15, 11, 20, 99};
+    cp::LazySegTree<cp::monoid::Min<int>, cp::action::Assign<int>> st(A);
+
+    printf("RMQ(1, 3) = %d\n", st.prod(1, 4)); // 13
+    st.apply(0, 4, 30);                        // A = {30,30,30,30,15,11,20,99}
+    printf("RMQ(1, 3) = %d\n", st.prod(1, 4)); // 30
+
+    // Range affine + range sum over Z/pZ
+    using mint = cp::Zn<998244353>; // requires "../number_theory/zn.h"
+    cp::LazySegTree<cp::monoid::Sum<mint>, cp::action::AffineSum<mint>> aff(std::vector<mint>(5, 1));
+    aff.apply(1, 4, {2, 3});                   // {1, 5, 5, 5, 1}
+    std::cout << aff.prod(0, 5) << std::endl;  // 17
+
+    // Range chmin + range max
+    cp::LazySegTree<cp::monoid::Max<int>, cp::action::Chmin<int>> ch(std::vector<int>{5, -2, 8, 3});
+    ch.apply(0, 4, 4);                         // {4, -2, 4, 3}
+    printf("max = %d\n", ch.all_prod());       // 4
+    return 0;
+}
+*/
@@ -0,0 +1,46 @@
+#pragma once
+/*
+ * Monoid policies
+ * A monoid policy describes an associative operation with an identity element:
+ *   using value_type = T;
+ *   static constexpr T identity();
+ *   static constexpr T combine(const T &a, const T &b);
+ * Being static member functions, they are resolved at compile time and inline
+ * into the data structures that take them as a template parameter.
+ */
+
+#include <limits>
+#include <algorithm>
+
+namespace cp
+{
+    namespace monoid
+    {
+        /// @brief Minimum, with identity std::numeric_limits<T>::max().
+        template <typename T>
+        struct Min
+        {
+            using value_type = T;
+            static constexpr T identity() { return std::numeric_limits<T>::max(); }
+            static constexpr T combine(const T &a, const T &b) { return std::min(a, b); }
+        };
+
+        /// @brief Maximum, with identity std::numeric_limits<T>::lowest().
+        template <typename T>
+        struct Max
+        {
+            using value_type = T;
+            static constexpr T identity() { return std::numeric_limits<T>::lowest(); }
+            static constexpr T combine(const T &a, const T &b) { return std::max(a, b); }
+        };
+
+        /// @brief Addition, with identity T(0). Also works for `cp::Zn`.
+        template <typename T>
+        struct Sum
+        {
+            using value_type = T;
+            static constexpr T identity() { return T(0); }
+            static constexpr T combine(const T &a, const T &b) { return a + b; }
+        };
+    }
+}
@@ -1,249 +1,1418 @@
-#include <iostream>
-#include <vector>
-#include <numeric>
-#include <stdexcept>
-#include <algorithm>
-#include <functional>
-#include <type_traits>
-#include <sstream> // For std::stringstream
-#include <iomanip> // For std::setw
-
-// Forward declarations
-template <typename T>
-class NDArray;
-
-template <typename T>
-std::ostream &operator<<(std::ostream &os, const NDArray<T> &arr);
-
-/**
- * @brief A multi-dimensional array class like NumPy's ndarray.
- * @tparam T The type of elements to be stored in the array.
- */
-template <typename T>
-class NDArray
-{
-private:
-    std::vector<size_t> shape_;
-    std::vector<size_t> strides_;
-    std::vector<T> data_;
-
-    void calculate_strides()
-    {
-        strides_.resize(shape_.size());
-        if (strides_.empty())
-            return;
-
-        strides_.back() = 1;
-        for (int i = shape_.size() - 2; i >= 0; --i)
-        {
-            strides_[i] = strides_[i + 1] * shape_[i + 1];
-        }
-    }
-
-    size_t get_total_size() const
-    {
-        if (shape_.empty())
-            return 0;
-        return std::accumulate(shape_.begin(), shape_.end(), 1, std::multiplies<size_t>());
-    }
-
-    template <typename T_idx, typename... T_indices>
-    size_t get_flat_index_recursive(size_t dim, T_idx idx, T_indices... rest) const
-    {
-        if (idx >= shape_[dim])
-        {
-            throw std::out_of_range("Index is out of bounds for dimension " + std::to_string(dim));
-        }
-
-        if constexpr (sizeof...(rest) > 0)
-        {
-            return idx * strides_[dim] + get_flat_index_recursive(dim + 1, rest...);
-        }
-        else
-        {
-            return idx * strides_[dim];
-        }
-    }
-
-    size_t get_max_element_width() const
-    {
-        if (data_.empty())
-        {
-            return 0;
-        }
-        size_t max_width = 0;
-        for (const auto &val : data_)
-        {
-            std::stringstream ss;
-            ss << val;
-            max_width = std::max(max_width, ss.str().length());
-        }
-        return max_width;
-    }
-
-public:
-    // ================== CONSTRUCTORS ==================
-    NDArray() = default;
-
-    explicit NDArray(const std::vector<size_t> &shape) : shape_(shape)
-    {
-        data_.resize(get_total_size());
-        calculate_strides();
-    }
-
-    NDArray(const std::vector<size_t> &shape, const T &value) : shape_(shape)
-    {
-        data_.assign(get_total_size(), value);
-        calculate_strides();
-    }
-
-    // ================== ACCESSORS ==================
-    const std::vector<size_t> &shape() const { return shape_; }
-    size_t ndim() const { return shape_.size(); }
-    size_t size() const { return data_.size(); }
-
-    // ================== ELEMENT ACCESS ==================
-    T &operator()(const std::vector<size_t> &indices)
-    {
-        if (indices.size() != ndim())
-        {
-            throw std::out_of_range("Incorrect number of indices provided.");
-        }
-        size_t index = std::inner_product(indices.begin(), indices.end(), strides_.begin(), 0);
-        return data_[index];
-    }
-
-    const T &operator()(const std::vector<size_t> &indices) const
-    {
-        if (indices.size() != ndim())
-        {
-            throw std::out_of_range("Incorrect number of indices provided.");
-        }
-        size_t index = std::inner_product(indices.begin(), indices.end(), strides_.begin(), 0);
-        return data_[index];
-    }
-
-    template <typename... Args>
-    T &operator()(Args... indices)
-    {
-        static_assert(std::conjunction_v<std::is_integral<Args>...>, "Indices must be integral types.");
-        if (sizeof...(indices) != ndim())
-        {
-            throw std::out_of_range("Incorrect number of indices provided.");
-        }
-        return data_[get_flat_index_recursive(0, indices...)];
-    }
-
-    template <typename... Args>
-    const T &operator()(Args... indices) const
-    {
-        static_assert(std::conjunction_v<std::is_integral<Args>...>, "Indices must be integral types.");
-        if (sizeof...(indices) != ndim())
-        {
-            throw std::out_of_range("Incorrect number of indices provided.");
-        }
-        return data_[get_flat_index_recursive(0, indices...)];
-    }
-
-    // ================== MANIPULATION ==================
-    void reshape(const std::vector<size_t> &new_shape)
-    {
-        NDArray temp(new_shape);
-        if (temp.size() != this->size())
-        {
-            throw std::runtime_error("Cannot reshape: new shape must have the same total number of elements.");
-        }
-        shape_ = new_shape;
-        calculate_strides();
-    }
-
-    void fill(const T &value)
-    {
-        std::fill(data_.begin(), data_.end(), value);
-    }
-
-    friend std::ostream &operator<< <>(std::ostream &os, const NDArray<T> &arr);
-};
-
-// ================== PRETTY PRINTING (FINAL VERSION) ==================
-namespace detail
-{
-    template <typename T>
-    void print_recursive(std::ostream &os, const NDArray<T> &arr, std::vector<size_t> &indices, size_t dim, size_t element_width)
-    {
-        if (dim == arr.ndim())
-        {
-            os << std::setw(element_width) << arr(indices);
-            return;
-        }
-
-        os << "[";
-        for (size_t i = 0; i < arr.shape()[dim]; ++i)
-        {
-            indices[dim] = i;
-            print_recursive(os, arr, indices, dim + 1, element_width);
-
-            if (i < arr.shape()[dim] - 1)
-            {
-                if (dim == arr.ndim() - 1)
-                {
-                    os << ", ";
-                }
-                else
-                {
-                    os << ",\n"
-                       << std::string(dim + 1, ' ');
-                }
-            }
-        }
-        os << "]";
-    }
-} // namespace detail
-
-template <typename T>
-std::ostream &operator<<(std::ostream &os, const NDArray<T> &arr)
-{
-    if (arr.size() == 0)
-    {
-        os << "[]";
-        return os;
-    }
-    size_t width = arr.get_max_element_width();
-    std::vector<size_t> indices(arr.ndim(), 0);
-    detail::print_recursive(os, arr, indices, 0, width);
-    return os;
-}
-
-/*
-// ================== MAIN FUNCTION (EXAMPLE USAGE) ==================
-int main()
-{
-    std::cout << "## 2D Array (3x4) with new syntax ##" << std::endl;
-    NDArray<int> a({3, 4}, 5);
-
-    a(0, 1) = 100;
-    a(2, 3) = 200;
-
-    std::cout << "Modified array a:\n"
-              << a << std::endl;
-    std::cout << "Value at a(0, 1) is: " << a(0, 1) << std::endl;
-
-    std::cout << "\n## 3D Array (2x3x4) with new syntax ##" << std::endl;
-    NDArray<double> b({2, 3, 4});
-    double counter = 0.0;
-    for (size_t i = 0; i < b.shape()[0]; ++i)
-    {
-        for (size_t j = 0; j < b.shape()[1]; ++j)
-        {
-            for (size_t k = 0; k < b.shape()[2]; ++k)
-            {
-                b(i, j, k) = counter++;
-            }
-        }
-    }
-    std::cout << "3D array b:\n"
-              << b << std::endl;
-
-    return 0;
-}
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <array>
+#include <span>
+#include <cstddef>
+#include <initializer_list>
+#include <numeric>
+#include <stdexcept>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <sstream> // For std::stringstream
+#include <iomanip> // For std::setw
+#include <memory>
+#include <thread>
+
+#include "../memory/aligned_allocator.h"
+
+/// @brief Arithmetic elements get cache-line aligned storage; everything else uses std::allocator.
+template <typename T>
+using ndarray_default_allocator = std::conditional_t<std::is_arithmetic_v<T>, cp::AlignedAllocator<T, 64>, std::allocator<T>>;
+
+/// @brief Tag: leave elements default-initialized (unwritten for trivial T) instead of zeroing them.
+struct ndarray_uninitialized_t
+{
+    explicit ndarray_uninitialized_t() = default;
+};
+inline constexpr ndarray_uninitialized_t ndarray_uninitialized{};
+
+/// @brief Tag: pad the innermost dimension to a whole number of cache lines.
+struct ndarray_padded_t
+{
+    explicit ndarray_padded_t() = default;
+};
+inline constexpr ndarray_padded_t ndarray_padded{};
+
+namespace ndarray_detail
+{
+    constexpr size_t CACHE_LINE = 64;
+
+    /**
+     * @brief The row pitch (in elements) for an innermost extent of n elements.
+     *
+     * Rounds n up to whole cache lines. A pitch that is a multiple of 4 KiB
+     * also gets one extra line, so consecutive rows do not map to the same
+     * cache set. Types whose size does not divide 64 are not padded.
+     */
+    template <typename T>
+    constexpr size_t padded_extent(size_t n)
+    {
+        if (CACHE_LINE % sizeof(T) != 0 || n == 0)
+            return n;
+        size_t per_line = CACHE_LINE / sizeof(T);
+        size_t pitch = (n + per_line - 1) / per_line * per_line;
+        if (pitch * sizeof(T) % 4096 == 0)
+            pitch += per_line;
+        return pitch;
+    }
+}
+
+// Forward declarations
+template <typename T, typename Alloc = ndarray_default_allocator<T>>
+class NDArray;
+
+template <typename T>
+class NDArrayView;
+
+template <typename T, typename Alloc>
+std::ostream &operator<<(std::ostream &os, const NDArray<T, Alloc> &arr);
+
+/**
+ * @brief A non-owning, strided view into the elements of an NDArray (or any buffer).
+ * @tparam T The element type; use `const T` for a read-only view.
+ *
+ * A view is a pointer, shape, strides and offset kept inline (no heap), so
+ * slice, select, transpose, permute, broadcast_to, squeeze and unsqueeze
+ * build a new view in O(ndim) without touching the elements. A view does not
+ * keep its buffer alive.
+ */
+template <typename T>
+class NDArrayView
+{
+public:
+    static constexpr size_t MAX_DIMS = 8;
+
+private:
+    T *data_ = nullptr;
+    size_t offset_ = 0;
+    size_t ndim_ = 0;
+    std::array<size_t, MAX_DIMS> shape_{};
+    std::array<std::ptrdiff_t, MAX_DIMS> strides_{};
+
+    void check_dim(size_t dim) const
+    {
+        if (dim >= ndim_)
+        {
+            throw std::out_of_range("Dimension " + std::to_string(dim) + " is out of range.");
+        }
+    }
+
+    template <typename T_idx, typename... T_indices>
+    std::ptrdiff_t get_flat_index_recursive(size_t dim, T_idx idx, T_indices... rest) const
+    {
+        if (static_cast<size_t>(idx) >= shape_[dim])
+        {
+            throw std::out_of_range("Index is out of bounds for dimension " + std::to_string(dim));
+        }
+
+        if constexpr (sizeof...(rest) > 0)
+        {
+            return static_cast<std::ptrdiff_t>(idx) * strides_[dim] + get_flat_index_recursive(dim + 1, rest...);
+        }
+        else
+        {
+            return static_cast<std::ptrdiff_t>(idx) * strides_[dim];
+        }
+    }
+
+    template <typename F>
+    void for_each_recursive(size_t dim, std::ptrdiff_t pos, F &f) const
+    {
+        if (dim == ndim_)
+        {
+            f(data_[pos]);
+            return;
+        }
+        for (size_t i = 0; i < shape_[dim]; ++i, pos += strides_[dim])
+        {
+            for_each_recursive(dim + 1, pos, f);
+        }
+    }
+
+public:
+    // ================== CONSTRUCTORS ==================
+    NDArrayView() = default;
+
+    /**
+     * @brief Views `data` with the given shape and element strides.
+     * @param strides Strides in elements; empty means row-major contiguous.
+     */
+    NDArrayView(T *data, std::span<const size_t> shape, std::span<const std::ptrdiff_t> strides = {})
+        : data_(data), ndim_(shape.size())
+    {
+        if (ndim_ > MAX_DIMS)
+        {
+            throw std::invalid_argument("NDArrayView supports at most " + std::to_string(MAX_DIMS) + " dimensions.");
+        }
+        if (!strides.empty() && strides.size() != ndim_)
+        {
+            throw std::invalid_argument("Shape and strides must have the same length.");
+        }
+        std::copy(shape.begin(), shape.end(), shape_.begin());
+        if (!strides.empty())
+        {
+            std::copy(strides.begin(), strides.end(), strides_.begin());
+        }
+        else
+        {
+            std::ptrdiff_t stride = 1;
+            for (size_t d = ndim_; d-- > 0;)
+            {
+                strides_[d] = stride;
+                stride *= static_cast<std::ptrdiff_t>(shape_[d]);
+            }
+        }
+    }
+
+    NDArrayView(T *data, std::initializer_list<size_t> shape)
+        : NDArrayView(data, std::span<const size_t>(shape.begin(), shape.size())) {}
+
+    /// @brief A mutable view converts to a read-only one.
+    template <typename U, typename = std::enable_if_t<std::is_same_v<const U, T>>>
+    NDArrayView(const NDArrayView<U> &other)
+        : data_(other.base()), offset_(other.offset()), ndim_(other.ndim())
+    {
+        std::copy(other.shape().begin(), other.shape().end(), shape_.begin());
+        std::copy(other.strides().begin(), other.strides().end(), strides_.begin());
+    }
+
+    // ================== ACCESSORS ==================
+    std::span<const size_t> shape() const { return {shape_.data(), ndim_}; }
+    std::span<const std::ptrdiff_t> strides() const { return {strides_.data(), ndim_}; }
+    size_t ndim() const { return ndim_; }
+    size_t offset() const { return offset_; }
+
+    /// @brief The buffer the offset and strides are relative to.
+    T *base() const { return data_; }
+
+    /// @brief The address of the first element.
+    T *data() const { return data_ + offset_; }
+
+    size_t size() const
+    {
+        return std::accumulate(shape_.begin(), shape_.begin() + ndim_, size_t(1), std::multiplies<size_t>());
+    }
+
+    /// @brief Returns whether the elements are laid out row-major with no gaps.
+    bool is_contiguous() const
+    {
+        std::ptrdiff_t expected = 1;
+        for (size_t d = ndim_; d-- > 0;)
+        {
+            if (shape_[d] != 1 && strides_[d] != expected)
+            {
+                return false;
+            }
+            expected *= static_cast<std::ptrdiff_t>(shape_[d]);
+        }
+        return true;
+    }
+
+    // ================== ELEMENT ACCESS ==================
+    template <typename... Args>
+    T &operator()(Args... indices) const
+    {
+        static_assert(std::conjunction_v<std::is_integral<Args>...>, "Indices must be integral types.");
+        if (sizeof...(indices) != ndim_)
+        {
+            throw std::out_of_range("Incorrect number of indices provided.");
+        }
+        if constexpr (sizeof...(indices) == 0)
+        {
+            return data_[offset_];
+        }
+        else
+        {
+            return data_[static_cast<std::ptrdiff_t>(offset_) + get_flat_index_recursive(0, indices...)];
+        }
+    }
+
+    T &operator()(const std::vector<size_t> &indices) const
+    {
+        if (indices.size() != ndim_)
+        {
+            throw std::out_of_range("Incorrect number of indices provided.");
+        }
+        std::ptrdiff_t pos = static_cast<std::ptrdiff_t>(offset_);
+        for (size_t d = 0; d < ndim_; ++d)
+        {
+            if (indices[d] >= shape_[d])
+            {
+                throw std::out_of_range("Index is out of bounds for dimension " + std::to_string(d));
+            }
+            pos += static_cast<std::ptrdiff_t>(indices[d]) * strides_[d];
+        }
+        return data_[pos];
+    }
+
+    /// @brief Calls f(element) for every element in row-major order.
+    template <typename F>
+    void for_each(F &&f) const
+    {
+        if (size() != 0)
+        {
+            for_each_recursive(0, static_cast<std::ptrdiff_t>(offset_), f);
+        }
+    }
+
+    /// @brief Copies the viewed elements into a new, contiguous NDArray.
+    NDArray<std::remove_const_t<T>> copy() const
+    {
+        NDArray<std::remove_const_t<T>> out(std::vector<size_t>(shape_.begin(), shape_.begin() + ndim_));
+        if (out.size() != size())
+        {
+            return out; // 0-dimensional views have no NDArray equivalent
+        }
+        auto *dst = out.data();
+        for_each([&dst](const T &x)
+                 { *dst++ = x; });
+        return out;
+    }
+
+    // ================== VIEW MANIPULATION ==================
+    /**
+     * @brief Restricts dimension `dim` to indices start, start + step, ... below stop.
+     * @complexity O(ndim), no allocation.
+     */
+    NDArrayView slice(size_t dim, size_t start, size_t stop, size_t step = 1) const
+    {
+        check_dim(dim);
+        if (step == 0)
+        {
+            throw std::invalid_argument("Slice step must be positive.");
+        }
+        stop = std::min(stop, shape_[dim]);
+        start = std::min(start, stop);
+        NDArrayView res = *this;
+        res.offset_ = static_cast<size_t>(static_cast<std::ptrdiff_t>(offset_) + static_cast<std::ptrdiff_t>(start) * strides_[dim]);
+        res.shape_[dim] = (stop - start + step - 1) / step;
+        res.strides_[dim] = strides_[dim] * static_cast<std::ptrdiff_t>(step);
+        return res;
+    }
+
+    /**
+     * @brief Fixes dimension `dim` at `index`, dropping that dimension (e.g. a row of a matrix).
+     * @complexity O(ndim), no allocation.
+     */
+    NDArrayView select(size_t dim, size_t index) const
+    {
+        check_dim(dim);
+        if (index >= shape_[dim])
+        {
+            throw std::out_of_range("Index is out of bounds for dimension " + std::to_string(dim));
+        }
+        NDArrayView res = *this;
+        res.offset_ = static_cast<size_t>(static_cast<std::ptrdiff_t>(offset_) + static_cast<std::ptrdiff_t>(index) * strides_[dim]);
+        std::copy(shape_.begin() + dim + 1, shape_.begin() + ndim_, res.shape_.begin() + dim);
+        std::copy(strides_.begin() + dim + 1, strides_.begin() + ndim_, res.strides_.begin() + dim);
+        --res.ndim_;
+        return res;
+    }
+
+    /// @brief Shorthand for select(0, index).
+    NDArrayView operator[](size_t index) const { return select(0, index); }
+
+    /// @brief Reorders dimensions: dimension d of the result is dimension order[d] of this view.
+    NDArrayView permute(std::span<const size_t> order) const
+    {
+        if (order.size() != ndim_)
+        {
+            throw std::invalid_argument("Permutation length must equal ndim.");
+        }
+        std::array<bool, MAX_DIMS> seen{};
+        NDArrayView res = *this;
+        for (size_t d = 0; d < ndim_; ++d)
+        {
+            if (order[d] >= ndim_ || seen[order[d]])
+            {
+                throw std::invalid_argument("Invalid permutation of dimensions.");
+            }
+            seen[order[d]] = true;
+            res.shape_[d] = shape_[order[d]];
+            res.strides_[d] = strides_[order[d]];
+        }
+        return res;
+    }
+
+    NDArrayView permute(std::initializer_list<size_t> order) const
+    {
+        return permute(std::span<const size_t>(order.begin(), order.size()));
+    }
+
+    /// @brief Reverses the order of all dimensions.
+    NDArrayView transpose() const
+    {
+        NDArrayView res = *this;
+        std::reverse(res.shape_.begin(), res.shape_.begin() + ndim_);
+        std::reverse(res.strides_.begin(), res.strides_.begin() + ndim_);
+        return res;
+    }
+
+    /// @brief Swaps dimensions d0 and d1.
+    NDArrayView transpose(size_t d0, size_t d1) const
+    {
+        check_dim(d0);
+        check_dim(d1);
+        NDArrayView res = *this;
+        std::swap(res.shape_[d0], res.shape_[d1]);
+        std::swap(res.strides_[d0], res.strides_[d1]);
+        return res;
+    }
+
+    /**
+     * @brief Broadcasts to `shape` with NumPy rules: trailing dimensions are
+     * aligned, and size-1 or missing dimensions repeat with stride 0.
+     */
+    NDArrayView broadcast_to(std::span<const size_t> shape) const
+    {
+        if (shape.size() < ndim_ || shape.size() > MAX_DIMS)
+        {
+            throw std::invalid_argument("Cannot broadcast to a shape with fewer dimensions or more than MAX_DIMS.");
+        }
+        NDArrayView res = *this;
+        res.ndim_ = shape.size();
+        size_t lead = shape.size() - ndim_;
+        for (size_t d = 0; d < shape.size(); ++d)
+        {
+            res.shape_[d] = shape[d];
+            if (d < lead)
+            {
+                res.strides_[d] = 0;
+            }
+            else if (shape_[d - lead] == shape[d])
+            {
+                res.strides_[d] = strides_[d - lead];
+            }
+            else if (shape_[d - lead] == 1)
+            {
+                res.strides_[d] = 0;
+            }
+            else
+            {
+                throw std::invalid_argument("Shapes are not broadcast-compatible.");
+            }
+        }
+        return res;
+    }
+
+    NDArrayView broadcast_to(std::initializer_list<size_t> shape) const
+    {
+        return broadcast_to(std::span<const size_t>(shape.begin(), shape.size()));
+    }
+
+    /// @brief Removes every dimension of size 1.
+    NDArrayView squeeze() const
+    {
+        NDArrayView res = *this;
+        res.ndim_ = 0;
+        for (size_t d = 0; d < ndim_; ++d)
+        {
+            if (shape_[d] != 1)
+            {
+                res.shape_[res.ndim_] = shape_[d];
+                res.strides_[res.ndim_++] = strides_[d];
+            }
+        }
+        return res;
+    }
+
+    /// @brief Removes dimension `dim`, which must have size 1.
+    NDArrayView squeeze(size_t dim) const
+    {
+        check_dim(dim);
+        if (shape_[dim] != 1)
+        {
+            throw std::invalid_argument("Only dimensions of size 1 can be squeezed.");
+        }
+        return select(dim, 0);
+    }
+
+    /// @brief Inserts a dimension of size 1 before dimension `dim` (dim == ndim appends).
+    NDArrayView unsqueeze(size_t dim) const
+    {
+        if (dim > ndim_ || ndim_ == MAX_DIMS)
+        {
+            throw std::out_of_range("Cannot insert a dimension at " + std::to_string(dim));
+        }
+        NDArrayView res = *this;
+        std::copy_backward(shape_.begin() + dim, shape_.begin() + ndim_, res.shape_.begin() + ndim_ + 1);
+        std::copy_backward(strides_.begin() + dim, strides_.begin() + ndim_, res.strides_.begin() + ndim_ + 1);
+        res.shape_[dim] = 1;
+        res.strides_[dim] = 0;
+        ++res.ndim_;
+        return res;
+    }
+};
+
+// ================== EXPRESSION TEMPLATES ==================
+// `A + B * k` builds a small tree of expression objects instead of
+// temporaries. Assigning it to an NDArray (or reducing it) evaluates every
+// element in one pass over the flat buffers: out[i] = A[i] + B[i] * k.
+// Operands must have equal shapes (no broadcasting) and be contiguous, i.e.
+// not ndarray_padded; use view().copy() otherwise.
+namespace ndarray_expr
+{
+    /// @brief CRTP base of every expression node.
+    template <typename E>
+    struct Expr
+    {
+        const E &self() const { return static_cast<const E &>(*this); }
+
+        /// @brief Lazily applies f to every element.
+        template <typename F>
+        auto map(F f) const;
+
+        /// @brief Sums all elements in one pass.
+        auto sum() const
+        {
+            using V = typename E::value_type;
+            V acc = V(0);
+            for (size_t i = 0, n = self().size(); i < n; ++i)
+                acc += self()[i];
+            return acc;
+        }
+
+        /// @brief Returns the smallest element. Throws on an empty expression.
+        auto min() const { return extreme([](const auto &a, const auto &b)
+                                          { return b < a; }); }
+
+        /// @brief Returns the largest element. Throws on an empty expression.
+        auto max() const { return extreme([](const auto &a, const auto &b)
+                                          { return a < b; }); }
+
+    private:
+        template <typename Better>
+        auto extreme(Better replace) const
+        {
+            size_t n = self().size();
+            if (n == 0)
+                throw std::runtime_error("Reduction of an empty array.");
+            typename E::value_type best = self()[0];
+            for (size_t i = 1; i < n; ++i)
+            {
+                auto x = self()[i];
+                if (replace(best, x))
+                    best = x;
+            }
+            return best;
+        }
+    };
+
+    template <typename E>
+    inline constexpr bool is_expr_v = std::is_base_of_v<Expr<E>, E>;
+
+    inline size_t shape_size(const std::vector<size_t> &shape)
+    {
+        return shape.empty() ? 0 : std::accumulate(shape.begin(), shape.end(), size_t(1), std::multiplies<size_t>());
+    }
+
+    /// @brief A contiguous array operand.
+    template <typename T>
+    struct Leaf : Expr<Leaf<T>>
+    {
+        using value_type = T;
+        static constexpr bool has_shape = true;
+
+        const T *ptr;
+        const std::vector<size_t> *dims;
+
+        const T &operator[](size_t i) const { return ptr[i]; }
+        const std::vector<size_t> &shape() const { return *dims; }
+        size_t size() const { return shape_size(*dims); }
+    };
+
+    /// @brief A scalar operand, repeated for every element.
+    template <typename T>
+    struct Scalar : Expr<Scalar<T>>
+    {
+        using value_type = T;
+        static constexpr bool has_shape = false;
+
+        T value;
+
+        const T &operator[](size_t) const { return value; }
+    };
+
+    template <typename Op, typename L, typename R>
+    struct Binary : Expr<Binary<Op, L, R>>
+    {
+        using value_type = std::decay_t<decltype(Op{}(std::declval<L>()[0], std::declval<R>()[0]))>;
+        static constexpr bool has_shape = true;
+
+        L lhs;
+        R rhs;
+
+        Binary(L l, R r) : lhs(std::move(l)), rhs(std::move(r))
+        {
+            if constexpr (L::has_shape && R::has_shape)
+            {
+                if (lhs.shape() != rhs.shape())
+                {
+                    throw std::invalid_argument("Element-wise operands must have the same shape.");
+                }
+            }
+        }
+
+        value_type operator[](size_t i) const { return Op{}(lhs[i], rhs[i]); }
+
+        const std::vector<size_t> &shape() const
+        {
+            if constexpr (L::has_shape)
+                return lhs.shape();
+            else
+                return rhs.shape();
+        }
+
+        size_t size() const
+        {
+            if constexpr (L::has_shape)
+                return lhs.size();
+            else
+                return rhs.size();
+        }
+    };
+
+    template <typename F, typename E>
+    struct Unary : Expr<Unary<F, E>>
+    {
+        using value_type = std::decay_t<std::invoke_result_t<const F &, decltype(std::declval<E>()[0])>>;
+        static constexpr bool has_shape = true;
+
+        E inner;
+        F f;
+
+        Unary(E e, F fn) : inner(std::move(e)), f(std::move(fn)) {}
+
+        value_type operator[](size_t i) const { return f(inner[i]); }
+        const std::vector<size_t> &shape() const { return inner.shape(); }
+        size_t size() const { return inner.size(); }
+    };
+
+    template <typename E>
+    template <typename F>
+    auto Expr<E>::map(F f) const
+    {
+        return Unary<F, E>(self(), std::move(f));
+    }
+
+    /**
+     * @brief Evaluates out[i] = e[i] for i in [0, n), splitting the range over `threads` threads.
+     */
+    template <typename T, typename E>
+    void evaluate(T *out, const E &e, size_t n, unsigned threads)
+    {
+        if (threads <= 1 || n < 2 * threads)
+        {
+            for (size_t i = 0; i < n; ++i)
+                out[i] = e[i];
+            return;
+        }
+        std::vector<std::thread> pool;
+        size_t chunk = (n + threads - 1) / threads;
+        for (size_t lo = 0; lo < n; lo += chunk)
+        {
+            size_t hi = std::min(n, lo + chunk);
+            pool.emplace_back([out, &e, lo, hi]
+                              { for (size_t i = lo; i < hi; ++i) out[i] = e[i]; });
+        }
+        for (auto &th : pool)
+            th.join();
+    }
+} // namespace ndarray_expr
+
+/**
+ * @brief A multi-dimensional array class like NumPy's ndarray.
+ * @tparam T The type of elements to be stored in the array.
+ * @tparam Alloc The allocator for the element buffer. Arithmetic types default
+ *         to 64-byte aligned storage (cp::AlignedAllocator).
+ */
+template <typename T, typename Alloc>
+class NDArray
+{
+private:
+    std::vector<size_t> shape_;
+    std::vector<size_t> strides_;
+    std::vector<T, Alloc> data_;
+
+    template <typename U>
+    using rebind_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<U>;
+
+    /// @brief Strides for the shape; with `padded`, rows are ndarray_detail::padded_extent apart.
+    void calculate_strides(bool padded = false)
+    {
+        strides_.resize(shape_.size());
+        if (strides_.empty())
+            return;
+
+        strides_.back() = 1;
+        for (int i = shape_.size() - 2; i >= 0; --i)
+        {
+            size_t extent = shape_[i + 1];
+            if (padded && i == static_cast<int>(shape_.size()) - 2)
+                extent = ndarray_detail::padded_extent<T>(extent);
+            strides_[i] = strides_[i + 1] * extent;
+        }
+    }
+
+    size_t get_total_size() const
+    {
+        if (shape_.empty())
+            return 0;
+        return std::accumulate(shape_.begin(), shape_.end(), size_t(1), std::multiplies<size_t>());
+    }
+
+    /// @brief The number of buffer slots, including row padding.
+    size_t get_storage_size() const
+    {
+        if (shape_.empty() || get_total_size() == 0)
+            return 0;
+        return shape_.size() == 1 ? shape_[0] : strides_[0] * shape_[0];
+    }
+
+    template <typename T_idx, typename... T_indices>
+    size_t get_flat_index_recursive(size_t dim, T_idx idx, T_indices... rest) const
+    {
+        if (static_cast<size_t>(idx) >= shape_[dim])
+        {
+            throw std::out_of_range("Index is out of bounds for dimension " + std::to_string(dim));
+        }
+
+        if constexpr (sizeof...(rest) > 0)
+        {
+            return idx * strides_[dim] + get_flat_index_recursive(dim + 1, rest...);
+        }
+        else
+        {
+            return idx * strides_[dim];
+        }
+    }
+
+    template <typename U>
+    NDArrayView<U> make_view(U *base) const
+    {
+        std::array<std::ptrdiff_t, NDArrayView<U>::MAX_DIMS> strides{};
+        size_t n = std::min(strides_.size(), strides.size());
+        std::copy(strides_.begin(), strides_.begin() + n, strides.begin());
+        return NDArrayView<U>(base, shape_, std::span<const std::ptrdiff_t>(strides.data(), n));
+    }
+
+    /// @brief Calls f on every element in row-major order, skipping row padding. Any rank, unlike view().
+    template <typename F>
+    void for_each_element(F f) const
+    {
+        if (is_contiguous())
+        {
+            for (const T &val : data_)
+                f(val);
+            return;
+        }
+        for_each_element_recursive(0, 0, f);
+    }
+
+    template <typename F>
+    void for_each_element_recursive(size_t dim, size_t pos, F &f) const
+    {
+        if (dim == shape_.size())
+        {
+            f(data_[pos]);
+            return;
+        }
+        for (size_t i = 0; i < shape_[dim]; ++i, pos += strides_[dim])
+            for_each_element_recursive(dim + 1, pos, f);
+    }
+
+    size_t get_max_element_width() const
+    {
+        if (data_.empty())
+        {
+            return 0;
+        }
+        if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char> &&
+                      !std::is_same_v<T, signed char> && !std::is_same_v<T, unsigned char>)
+        {
+            // The widest integer is the largest or the smallest one: no formatting per element.
+            T lo = *data(), hi = *data();
+            for_each_element([&lo, &hi](const T &val)
+                             { lo = std::min(lo, val), hi = std::max(hi, val); });
+            return std::max(integer_width(lo), integer_width(hi));
+        }
+        else
+        {
+            size_t max_width = 0;
+            std::ostringstream ss;
+            for_each_element([&max_width, &ss](const T &val)
+                             {
+                ss.str(std::string());
+                ss << val;
+                max_width = std::max(max_width, static_cast<size_t>(ss.tellp())); });
+            return max_width;
+        }
+    }
+
+    static size_t integer_width(T x)
+    {
+        size_t width = 1;
+        if constexpr (std::is_signed_v<T>)
+        {
+            if (x < 0)
+            {
+                ++width;
+                while (x <= -10)
+                    x /= 10, ++width;
+                return width;
+            }
+        }
+        while (x >= 10)
+            x /= 10, ++width;
+        return width;
+    }
+
+public:
+    // ================== CONSTRUCTORS ==================
+    NDArray() = default;
+
+    explicit NDArray(const std::vector<size_t> &shape, const Alloc &alloc = Alloc()) : shape_(shape), data_(alloc)
+    {
+        calculate_strides();
+        data_.assign(get_storage_size(), T());
+    }
+
+    NDArray(const std::vector<size_t> &shape, const T &value, const Alloc &alloc = Alloc()) : shape_(shape), data_(alloc)
+    {
+        calculate_strides();
+        data_.assign(get_storage_size(), value);
+    }
+
+    /**
+     * @brief Allocates without writing the elements, for tables that are fully overwritten.
+     *
+     * Elements are default-initialized through the allocator: unwritten for trivial T
+     * with cp::AlignedAllocator, still value-initialized with std::allocator.
+     */
+    NDArray(const std::vector<size_t> &shape, ndarray_uninitialized_t, const Alloc &alloc = Alloc()) : shape_(shape), data_(alloc)
+    {
+        calculate_strides();
+        data_.resize(get_storage_size());
+    }
+
+    /**
+     * @brief Pads every innermost row to whole cache lines (see ndarray_detail::padded_extent).
+     *
+     * Rows never share a cache line, which avoids false sharing when threads own
+     * rows. The array is then no longer contiguous; index it or go through view().
+     */
+    NDArray(const std::vector<size_t> &shape, ndarray_padded_t, const T &value = T(), const Alloc &alloc = Alloc()) : shape_(shape), data_(alloc)
+    {
+        calculate_strides(true);
+        data_.assign(get_storage_size(), value);
+    }
+
+    NDArray(const std::vector<size_t> &shape, ndarray_padded_t, ndarray_uninitialized_t, const Alloc &alloc = Alloc()) : shape_(shape), data_(alloc)
+    {
+        calculate_strides(true);
+        data_.resize(get_storage_size());
+    }
+
+    /// @brief Evaluates an element-wise expression into a new array.
+    template <typename E>
+    NDArray(const ndarray_expr::Expr<E> &e) : NDArray(e.self().shape(), ndarray_uninitialized)
+    {
+        ndarray_expr::evaluate(data_.data(), e.self(), size(), 1);
+    }
+
+    // ================== ACCESSORS ==================
+    const std::vector<size_t> &shape() const { return shape_; }
+    const std::vector<size_t> &strides() const { return strides_; }
+    size_t ndim() const { return shape_.size(); }
+    size_t size() const { return get_total_size(); }
+    T *data() { return data_.data(); }
+    const T *data() const { return data_.data(); }
+
+    /// @brief Returns whether the elements are stored row-major without padding.
+    bool is_contiguous() const { return data_.size() == size(); }
+
+    // ================== VIEWS ==================
+    /// @brief A view of the whole array; slice/transpose/... it without copying.
+    NDArrayView<T> view() { return make_view<T>(data_.data()); }
+    NDArrayView<const T> view() const { return make_view<const T>(data_.data()); }
+
+    operator NDArrayView<T>() { return view(); }
+    operator NDArrayView<const T>() const { return view(); }
+
+    // ================== ELEMENT ACCESS ==================
+    T &operator()(const std::vector<size_t> &indices)
+    {
+        if (indices.size() != ndim())
+        {
+            throw std::out_of_range("Incorrect number of indices provided.");
+        }
+        size_t index = std::inner_product(indices.begin(), indices.end(), strides_.begin(), size_t(0));
+        return data_[index];
+    }
+
+    const T &operator()(const std::vector<size_t> &indices) const
+    {
+        if (indices.size() != ndim())
+        {
+            throw std::out_of_range("Incorrect number of indices provided.");
+        }
+        size_t index = std::inner_product(indices.begin(), indices.end(), strides_.begin(), size_t(0));
+        return data_[index];
+    }
+
+    template <typename... Args>
+    T &operator()(Args... indices)
+    {
+        static_assert(std::conjunction_v<std::is_integral<Args>...>, "Indices must be integral types.");
+        if (sizeof...(indices) != ndim())
+        {
+            throw std::out_of_range("Incorrect number of indices provided.");
+        }
+        return data_[get_flat_index_recursive(0, indices...)];
+    }
+
+    template <typename... Args>
+    const T &operator()(Args... indices) const
+    {
+        static_assert(std::conjunction_v<std::is_integral<Args>...>, "Indices must be integral types.");
+        if (sizeof...(indices) != ndim())
+        {
+            throw std::out_of_range("Incorrect number of indices provided.");
+        }
+        return data_[get_flat_index_recursive(0, indices...)];
+    }
+
+    // ================== MANIPULATION ==================
+    void reshape(const std::vector<size_t> &new_shape)
+    {
+        size_t new_size = new_shape.empty() ? 0 : std::accumulate(new_shape.begin(), new_shape.end(), size_t(1), std::multiplies<size_t>());
+        if (new_size != this->size())
+        {
+            throw std::runtime_error("Cannot reshape: new shape must have the same total number of elements.");
+        }
+        if (!is_contiguous())
+        {
+            throw std::runtime_error("Cannot reshape a padded array.");
+        }
+        shape_ = new_shape;
+        calculate_strides();
+    }
+
+    void fill(const T &value)
+    {
+        std::fill(data_.begin(), data_.end(), value);
+    }
+
+    // ================== ARITHMETIC ==================
+    /// @brief The array as an expression operand. Throws if the array is padded.
+    ndarray_expr::Leaf<T> expr() const
+    {
+        if (!is_contiguous())
+        {
+            throw std::invalid_argument("Expressions need contiguous (unpadded) arrays.");
+        }
+        return {{}, data_.data(), &shape_};
+    }
+
+    /**
+     * @brief Evaluates `e` into this array in one pass, optionally on several threads.
+     *
+     * The array is reallocated if its shape differs. `A.assign(A * 2 + B)` is
+     * safe: element i only reads element i of each operand.
+     * @complexity O(size / threads)
+     */
+    template <typename E>
+    NDArray &assign(const ndarray_expr::Expr<E> &e, unsigned threads = 1)
+    {
+        const E &x = e.self();
+        if (x.shape() != shape_ || !is_contiguous())
+        {
+            NDArray fresh(x.shape(), ndarray_uninitialized, data_.get_allocator());
+            ndarray_expr::evaluate(fresh.data_.data(), x, fresh.size(), threads);
+            *this = std::move(fresh);
+            return *this;
+        }
+        ndarray_expr::evaluate(data_.data(), x, size(), threads);
+        return *this;
+    }
+
+    template <typename E>
+    NDArray &operator=(const ndarray_expr::Expr<E> &e) { return assign(e); }
+
+    template <typename U>
+    NDArray &operator+=(const U &rhs) { return assign(*this + rhs); }
+    template <typename U>
+    NDArray &operator-=(const U &rhs) { return assign(*this - rhs); }
+    template <typename U>
+    NDArray &operator*=(const U &rhs) { return assign(*this * rhs); }
+    template <typename U>
+    NDArray &operator/=(const U &rhs) { return assign(*this / rhs); }
+
+    /// @brief Lazily applies f to every element (see ndarray_expr::Expr::map).
+    template <typename F>
+    auto map(F f) const { return expr().map(std::move(f)); }
+
+    // ================== REDUCTIONS ==================
+    T sum() const { return expr().sum(); }
+    T min() const { return expr().min(); }
+    T max() const { return expr().max(); }
+
+    /**
+     * @brief Sums along `axis`; the result drops that dimension (a 1-D input gives shape {1}).
+     * The result uses a copy of this array's allocator. Throws on an empty axis.
+     * @complexity O(size), one sequential pass.
+     */
+    NDArray<T, Alloc> sum(size_t axis) const
+    {
+        return reduce_axis(axis, [](T &acc, const T &x)
+                           { acc += x; });
+    }
+
+    /// @brief Minimum along `axis` (see sum(axis)).
+    NDArray<T, Alloc> min(size_t axis) const
+    {
+        return reduce_axis(axis, [](T &acc, const T &x)
+                           { if (x < acc) acc = x; });
+    }
+
+    /// @brief Maximum along `axis` (see sum(axis)).
+    NDArray<T, Alloc> max(size_t axis) const
+    {
+        return reduce_axis(axis, [](T &acc, const T &x)
+                           { if (acc < x) acc = x; });
+    }
+
+    /// @brief Index of the first maximum along `axis` (see sum(axis)); the allocator is rebound to size_t.
+    NDArray<size_t, rebind_alloc<size_t>> argmax(size_t axis) const
+    {
+        auto [outer, len, inner] = axis_extents(axis);
+        const T *src = contiguous_data();
+        if (len == 0)
+        {
+            throw std::runtime_error("Reduction along an empty axis.");
+        }
+        NDArray<size_t, rebind_alloc<size_t>> idx(reduced_shape(axis), size_t(0), rebind_alloc<size_t>(data_.get_allocator()));
+        std::vector<T> best(src, src + (outer == 0 ? 0 : inner));
+        for (size_t o = 0; o < outer; ++o)
+        {
+            const T *block = src + o * len * inner;
+            size_t *res = idx.data() + o * inner;
+            std::copy(block, block + inner, best.begin());
+            for (size_t k = 1; k < len; ++k)
+            {
+                for (size_t j = 0; j < inner; ++j)
+                {
+                    if (best[j] < block[k * inner + j])
+                    {
+                        best[j] = block[k * inner + j];
+                        res[j] = k;
+                    }
+                }
+            }
+        }
+        return idx;
+    }
+
+    friend std::ostream &operator<< <>(std::ostream &os, const NDArray<T, Alloc> &arr);
+
+private:
+    /// @brief (elements before, length of, elements after) the axis, for a row-major walk.
+    std::array<size_t, 3> axis_extents(size_t axis) const
+    {
+        if (axis >= ndim())
+        {
+            throw std::out_of_range("Axis " + std::to_string(axis) + " is out of range.");
+        }
+        size_t outer = std::accumulate(shape_.begin(), shape_.begin() + axis, size_t(1), std::multiplies<size_t>());
+        size_t inner = std::accumulate(shape_.begin() + axis + 1, shape_.end(), size_t(1), std::multiplies<size_t>());
+        return {outer, shape_[axis], inner};
+    }
+
+    std::vector<size_t> reduced_shape(size_t axis) const
+    {
+        std::vector<size_t> out(shape_);
+        out.erase(out.begin() + axis);
+        if (out.empty())
+            out.push_back(1);
+        return out;
+    }
+
+    const T *contiguous_data() const
+    {
+        if (!is_contiguous())
+        {
+            throw std::invalid_argument("Reductions need contiguous (unpadded) arrays.");
+        }
+        return data_.data();
+    }
+
+    /// @brief Folds each (outer, inner) fibre along the axis: the innermost loop is a unit-stride row.
+    template <typename Combine>
+    NDArray<T, Alloc> reduce_axis(size_t axis, Combine combine) const
+    {
+        auto [outer, len, inner] = axis_extents(axis);
+        const T *src = contiguous_data();
+        if (len == 0)
+        {
+            throw std::runtime_error("Reduction along an empty axis.");
+        }
+        NDArray<T, Alloc> out(reduced_shape(axis), ndarray_uninitialized, data_.get_allocator());
+        for (size_t o = 0; o < outer; ++o)
+        {
+            const T *block = src + o * len * inner;
+            T *acc = out.data() + o * inner;
+            std::copy(block, block + inner, acc);
+            for (size_t k = 1; k < len; ++k)
+            {
+                for (size_t j = 0; j < inner; ++j)
+                {
+                    combine(acc[j], block[k * inner + j]);
+                }
+            }
+        }
+        return out;
+    }
+};
+
+// ================== ELEMENT-WISE OPERATORS ==================
+namespace ndarray_expr
+{
+    template <typename T>
+    struct is_ndarray : std::false_type
+    {
+    };
+    template <typename T, typename Alloc>
+    struct is_ndarray<NDArray<T, Alloc>> : std::true_type
+    {
+    };
+
+    template <typename X>
+    inline constexpr bool is_operand_v = is_expr_v<X> || is_ndarray<X>::value;
+
+    /// @brief Wraps arrays as leaves and anything else as a scalar.
+    template <typename X>
+    auto as_expr(const X &x)
+    {
+        if constexpr (is_expr_v<X>)
+            return x;
+        else if constexpr (is_ndarray<X>::value)
+            return x.expr();
+        else
+            return Scalar<X>{{}, x};
+    }
+
+    template <typename Op, typename L, typename R>
+    auto make_binary(const L &l, const R &r)
+    {
+        using LE = decltype(as_expr(l));
+        using RE = decltype(as_expr(r));
+        return Binary<Op, LE, RE>(as_expr(l), as_expr(r));
+    }
+} // namespace ndarray_expr
+
+template <typename L, typename R>
+    requires(ndarray_expr::is_operand_v<L> || ndarray_expr::is_operand_v<R>)
+auto operator+(const L &l, const R &r) { return ndarray_expr::make_binary<std::plus<>>(l, r); }
+
+template <typename L, typename R>
+    requires(ndarray_expr::is_operand_v<L> || ndarray_expr::is_operand_v<R>)
+auto operator-(const L &l, const R &r) { return ndarray_expr::make_binary<std::minus<>>(l, r); }
+
+template <typename L, typename R>
+    requires(ndarray_expr::is_operand_v<L> || ndarray_expr::is_operand_v<R>)
+auto operator*(const L &l, const R &r) { return ndarray_expr::make_binary<std::multiplies<>>(l, r); }
+
+template <typename L, typename R>
+    requires(ndarray_expr::is_operand_v<L> || ndarray_expr::is_operand_v<R>)
+auto operator/(const L &l, const R &r) { return ndarray_expr::make_binary<std::divides<>>(l, r); }
+
+template <typename X>
+    requires ndarray_expr::is_operand_v<X>
+auto operator-(const X &x) { return ndarray_expr::as_expr(x).map(std::negate<>{}); }
+
+// ================== STATIC-RANK ARRAY ==================
+/**
+ * @brief An NDArray whose rank is a template parameter.
+ * @tparam T The type of elements to be stored in the array.
+ * @tparam Rank The number of dimensions, fixed at compile time.
+ *
+ * Shape and strides live in std::arrays, the index count is checked at
+ * compile time, and operator() compiles to one multiply-add chain. Bounds
+ * are checked (std::out_of_range) only when NDEBUG is not defined;
+ * at_unchecked never checks.
+ */
+template <typename T, size_t Rank, typename Alloc = ndarray_default_allocator<T>>
+class FixedNDArray
+{
+    static_assert(Rank >= 1, "FixedNDArray needs at least one dimension.");
+
+public:
+    using index_type = std::array<size_t, Rank>;
+
+private:
+    index_type shape_{};
+    index_type strides_{};
+    std::vector<T, Alloc> data_;
+
+    void calculate_strides(bool padded = false)
+    {
+        strides_[Rank - 1] = 1;
+        for (size_t i = Rank - 1; i-- > 0;)
+        {
+            size_t extent = padded && i == Rank - 2 ? ndarray_detail::padded_extent<T>(shape_[i + 1]) : shape_[i + 1];
+            strides_[i] = strides_[i + 1] * extent;
+        }
+    }
+
+    size_t get_storage_size() const { return strides_[0] * shape_[0]; }
+
+    size_t flat_index(const index_type &idx) const
+    {
+        // The last stride is always 1, so it is left out of the chain.
+        size_t pos = idx[Rank - 1];
+        for (size_t d = 0; d + 1 < Rank; ++d)
+        {
+            pos += idx[d] * strides_[d];
+        }
+        return pos;
+    }
+
+    void check_bounds([[maybe_unused]] const index_type &idx) const
+    {
+#ifndef NDEBUG
+        for (size_t d = 0; d < Rank; ++d)
+        {
+            if (idx[d] >= shape_[d])
+            {
+                throw std::out_of_range("Index is out of bounds for dimension " + std::to_string(d));
+            }
+        }
+#endif
+    }
+
+    template <typename... Args>
+    static index_type make_index(Args... indices)
+    {
+        static_assert(sizeof...(Args) == Rank, "Incorrect number of indices provided.");
+        static_assert(std::conjunction_v<std::is_integral<Args>...>, "Indices must be integral types.");
+        return {static_cast<size_t>(indices)...};
+    }
+
+public:
+    // ================== CONSTRUCTORS ==================
+    FixedNDArray() = default;
+
+    explicit FixedNDArray(const index_type &shape, const Alloc &alloc = Alloc()) : shape_(shape), data_(alloc)
+    {
+        calculate_strides();
+        data_.assign(get_storage_size(), T());
+    }
+
+    FixedNDArray(const index_type &shape, const T &value, const Alloc &alloc = Alloc()) : shape_(shape), data_(alloc)
+    {
+        calculate_strides();
+        data_.assign(get_storage_size(), value);
+    }
+
+    /// @brief Allocates without writing the elements (see NDArray).
+    FixedNDArray(const index_type &shape, ndarray_uninitialized_t, const Alloc &alloc = Alloc()) : shape_(shape), data_(alloc)
+    {
+        calculate_strides();
+        data_.resize(get_storage_size());
+    }
+
+    /// @brief Pads every innermost row to whole cache lines (see NDArray).
+    FixedNDArray(const index_type &shape, ndarray_padded_t, const T &value = T(), const Alloc &alloc = Alloc()) : shape_(shape), data_(alloc)
+    {
+        calculate_strides(true);
+        data_.assign(get_storage_size(), value);
+    }
+
+    FixedNDArray(const index_type &shape, ndarray_padded_t, ndarray_uninitialized_t, const Alloc &alloc = Alloc()) : shape_(shape), data_(alloc)
+    {
+        calculate_strides(true);
+        data_.resize(get_storage_size());
+    }
+
+    // ================== ACCESSORS ==================
+    const index_type &shape() const { return shape_; }
+    const index_type &strides() const { return strides_; }
+    static constexpr size_t ndim() { return Rank; }
+    size_t size() const
+    {
+        return std::accumulate(shape_.begin(), shape_.end(), size_t(1), std::multiplies<size_t>());
+    }
+    bool is_contiguous() const { return data_.size() == size(); }
+    T *data() { return data_.data(); }
+    const T *data() const { return data_.data(); }
+
+    // ================== ELEMENT ACCESS ==================
+    template <typename... Args>
+    T &operator()(Args... indices)
+    {
+        index_type idx = make_index(indices...);
+        check_bounds(idx);
+        return data_[flat_index(idx)];
+    }
+
+    template <typename... Args>
+    const T &operator()(Args... indices) const
+    {
+        index_type idx = make_index(indices...);
+        check_bounds(idx);
+        return data_[flat_index(idx)];
+    }
+
+    T &operator[](const index_type &idx)
+    {
+        check_bounds(idx);
+        return data_[flat_index(idx)];
+    }
+
+    const T &operator[](const index_type &idx) const
+    {
+        check_bounds(idx);
+        return data_[flat_index(idx)];
+    }
+
+    /// @brief Element access with no bounds check in any build.
+    template <typename... Args>
+    T &at_unchecked(Args... indices) { return data_[flat_index(make_index(indices...))]; }
+
+    template <typename... Args>
+    const T &at_unchecked(Args... indices) const { return data_[flat_index(make_index(indices...))]; }
+
+    // ================== MANIPULATION ==================
+    void fill(const T &value)
+    {
+        std::fill(data_.begin(), data_.end(), value);
+    }
+
+    // ================== VIEWS ==================
+    NDArrayView<T> view() { return make_view<T>(data_.data()); }
+    NDArrayView<const T> view() const { return make_view<const T>(data_.data()); }
+
+private:
+    template <typename U>
+    NDArrayView<U> make_view(U *base) const
+    {
+        std::array<std::ptrdiff_t, Rank> strides;
+        std::copy(strides_.begin(), strides_.end(), strides.begin());
+        return NDArrayView<U>(base, shape_, strides);
+    }
+};
+
+// ================== PRETTY PRINTING (FINAL VERSION) ==================
+namespace detail
+{
+    template <typename T, typename Alloc>
+    void print_recursive(std::ostream &os, const NDArray<T, Alloc> &arr, std::vector<size_t> &indices, size_t dim, size_t element_width)
+    {
+        if (dim == arr.ndim())
+        {
+            os << std::setw(element_width) << arr(indices);
+            return;
+        }
+
+        os << "[";
+        for (size_t i = 0; i < arr.shape()[dim]; ++i)
+        {
+            indices[dim] = i;
+            print_recursive(os, arr, indices, dim + 1, element_width);
+
+            if (i < arr.shape()[dim] - 1)
+            {
+                if (dim == arr.ndim() - 1)
+                {
+                    os << ", ";
+                }
+                else
+                {
+                    os << ",\n"
+                       << std::string(dim + 1, ' ');
+                }
+            }
+        }
+        os << "]";
+    }
+} // namespace detail
+
+template <typename T, typename Alloc>
+std::ostream &operator<<(std::ostream &os, const NDArray<T, Alloc> &arr)
+{
+    if (arr.size() == 0)
+    {
+        os << "[]";
+        return os;
+    }
+    size_t width = arr.get_max_element_width();
+    std::vector<size_t> indices(arr.ndim(), 0);
+    detail::print_recursive(os, arr, indices, 0, width);
+    return os;
+}
+
+/*
+// ================== MAIN FUNCTION (EXAMPLE USAGE) ==================
+int main()
+{
+    std::cout << "## 2D Array (3x4) with new syntax ##" << std::endl;
+    NDArray<int> a({3, 4}, 5);
+
+    a(0, 1) = 100;
+    a(2, 3) = 200;
+
+    std::cout << "Modified array a:\n"
+              << a << std::endl;
+    std::cout << "Value at a(0, 1) is: " << a(0, 1) << std::endl;
+
+    std::cout << "\n## 3D Array (2x3x4) with new syntax ##" << std::endl;
+    NDArray<double> b({2, 3, 4});
+    double counter = 0.0;
+    for (size_t i = 0; i < b.shape()[0]; ++i)
+    {
+        for (size_t j = 0; j < b.shape()[1]; ++j)
+        {
+            for (size_t k = 0; k < b.shape()[2]; ++k)
+            {
+                b(i, j, k) = counter++;
+            }
+        }
+    }
+    std::cout << "3D array b:\n"
+              << b << std::endl;
+
+    std::cout << "\n## Views (no copies) ##" << std::endl;
+    NDArrayView<double> v = b.view();
+    NDArrayView<double> plane = v[1];                        // b(1, :, :), shape 3x4
+    NDArrayView<double> evens = plane.slice(1, 0, 4, 2);     // columns 0 and 2, shape 3x2
+    NDArrayView<double> cols = evens.transpose();            // shape 2x3
+    std::cout << cols(1, 2) << std::endl;                    // b(1, 2, 2) = 22
+    NDArrayView<double> row = v.select(1, 0).unsqueeze(1);   // shape 2x1x4
+    std::cout << row.broadcast_to({2, 3, 4})(1, 2, 3) << std::endl; // b(1, 0, 3) = 15
+    std::cout << cols.copy() << std::endl;
+
+    std::cout << "\n## Static rank (DP tables) ##" << std::endl;
+    FixedNDArray<long long, 3> dp({4, 5, 6}, 0);
+    dp(1, 2, 3) = 7;                               // index count checked at compile time
+    dp.at_unchecked(1, 2, 4) = dp[{1, 2, 3}] + 1;  // no bounds check in any build
+    std::cout << dp(1, 2, 4) << std::endl;         // 8
+
+    std::cout << "\n## Storage options ##" << std::endl;
+    NDArray<int> scratch({1000, 1000}, ndarray_uninitialized); // no zeroing pass, 64-byte aligned
+    NDArray<int> rows({8, 3}, ndarray_padded, 0);              // each row starts on its own cache line
+    std::cout << rows.strides()[0] << " " << rows.is_contiguous() << std::endl; // 16 0
+
+    std::cout << "\n## Element-wise arithmetic ##" << std::endl;
+    NDArray<long long> x({2, 3}, 2), y({2, 3}, 5);
+    NDArray<long long> z = x * 3 + y;            // one pass, no temporaries
+    z.assign(z - x.map([](long long v) { return v * v; }), 4); // 4 threads
+    std::cout << z.sum() << std::endl;           // 42
+    std::cout << z.sum(0) << std::endl;          // [14, 14, 14]
+    std::cout << z.argmax(1) << std::endl;       // [0, 0]
+
+    return 0;
+}
 */
\ No newline at end of file
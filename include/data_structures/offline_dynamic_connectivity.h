@@ -0,0 +1,218 @@
+#pragma once
+/*
+ * Offline Dynamic Connectivity (segment tree over time)
+ * Operation: O(1) add_edge(u, v), remove_edge(u, v), add_query()
+ * Operation: O(q log q log n) solve(on_query) for q events
+ */
+
+// Every edge is alive on a half-open interval of query times [added, removed).
+// Each interval is stored in the O(log q) segment-tree nodes that cover it.
+// A DFS over the tree unions a node's edges on entry and rolls them back on
+// exit, so at leaf t the RollbackUnionFind holds exactly the edges alive at
+// query t. Edge lists are kept in one flat (CSR) array instead of one vector
+// per node.
+
+#include <vector>
+#include <array>
+#include <tuple>
+#include <utility>
+#include <algorithm>
+
+#include "union_find.h"
+
+namespace cp
+{
+    /**
+     * @brief Answers connectivity queries over a sequence of edge insertions and deletions.
+     *
+     * Events are recorded first and processed all at once by `solve()`. Parallel
+     * edges are supported: each `remove_edge(u, v)` cancels one earlier
+     * `add_edge(u, v)`.
+     */
+    class OfflineDynamicConnectivity
+    {
+    private:
+        struct Event
+        {
+            int u, v, time;
+            bool add;
+        };
+
+        int m_n;
+        int m_queries = 0;
+        std::vector<Event> m_events;
+
+        int m_size = 1;
+        std::vector<int> m_start;                 // CSR offsets per tree node
+        std::vector<std::pair<int, int>> m_edges; // CSR payload
+
+        template <typename F>
+        void dfs(int node, RollbackUnionFind &dsu, F &on_query)
+        {
+            int snap = dsu.snapshot();
+            for (int k = m_start[node]; k < m_start[node + 1]; ++k)
+            {
+                dsu.unionSet(m_edges[k].first, m_edges[k].second);
+            }
+
+            if (node >= m_size)
+            {
+                if (node - m_size < m_queries)
+                {
+                    on_query(node - m_size, dsu);
+                }
+            }
+            else
+            {
+                dfs(2 * node, dsu, on_query);
+                dfs(2 * node + 1, dsu, on_query);
+            }
+            dsu.rollback(snap);
+        }
+
+    public:
+        /// @param n The number of vertices, labelled 0..n-1.
+        explicit OfflineDynamicConnectivity(int n) : m_n(n) {}
+
+        /// @brief Inserts the undirected edge (u, v) before the next query.
+        void add_edge(int u, int v)
+        {
+            m_events.push_back({std::min(u, v), std::max(u, v), m_queries, true});
+        }
+
+        /// @brief Deletes one copy of the undirected edge (u, v) before the next query.
+        void remove_edge(int u, int v)
+        {
+            m_events.push_back({std::min(u, v), std::max(u, v), m_queries, false});
+        }
+
+        /**
+         * @brief Records a query point over the current edge set.
+         * @return The query index, passed back to the callback in `solve()`.
+         */
+        int add_query()
+        {
+            return m_queries++;
+        }
+
+        /**
+         * @brief Processes all events, calling on_query(q, dsu) for every query in order.
+         * @param on_query Callable as on_query(int, RollbackUnionFind &). The DSU
+         *        must be used read-only (findSet, isSameSet, sizeOfSet, ...).
+         * @complexity O(q log q log n)
+         */
+        template <typename F>
+        void solve(F &&on_query)
+        {
+            if (m_queries == 0)
+            {
+                return;
+            }
+
+            // Pair every removal with an earlier insertion of the same edge.
+            std::stable_sort(m_events.begin(), m_events.end(), [](const Event &a, const Event &b)
+                             { return std::tie(a.u, a.v) < std::tie(b.u, b.v); });
+            std::vector<std::array<int, 4>> intervals; // {from, to, u, v}
+            std::vector<int> open;
+            for (size_t i = 0; i < m_events.size();)
+            {
+                size_t j = i;
+                open.clear();
+                for (; j < m_events.size() && m_events[j].u == m_events[i].u && m_events[j].v == m_events[i].v; ++j)
+                {
+                    if (m_events[j].add)
+                    {
+                        open.push_back(m_events[j].time);
+                    }
+                    else if (!open.empty())
+                    {
+                        if (open.back() < m_events[j].time)
+                        {
+                            intervals.push_back({open.back(), m_events[j].time, m_events[i].u, m_events[i].v});
+                        }
+                        open.pop_back();
+                    }
+                }
+                for (int from : open)
+                {
+                    if (from < m_queries)
+                    {
+                        intervals.push_back({from, m_queries, m_events[i].u, m_events[i].v});
+                    }
+                }
+                i = j;
+            }
+
+            // Distribute intervals over the segment tree nodes (two passes: count, then fill).
+            m_size = 1;
+            while (m_size < m_queries)
+            {
+                m_size <<= 1;
+            }
+            m_start.assign(2 * m_size + 1, 0);
+            auto for_each_node = [&](const std::array<int, 4> &it, auto &&visit)
+            {
+                for (int l = it[0] + m_size, r = it[1] + m_size; l < r; l >>= 1, r >>= 1)
+                {
+                    if (l & 1)
+                        visit(l++);
+                    if (r & 1)
+                        visit(--r);
+                }
+            };
+            for (const auto &it : intervals)
+            {
+                for_each_node(it, [&](int node)
+                              { ++m_start[node + 1]; });
+            }
+            for (int node = 0; node < 2 * m_size; ++node)
+            {
+                m_start[node + 1] += m_start[node];
+            }
+            m_edges.resize(m_start[2 * m_size]);
+            std::vector<int> fill(m_start.begin(), m_start.end() - 1);
+            for (const auto &it : intervals)
+            {
+                for_each_node(it, [&](int node)
+                              { m_edges[fill[node]++] = {it[2], it[3]}; });
+            }
+
+            RollbackUnionFind dsu(m_n);
+            dfs(1, dsu, on_query);
+        }
+
+        /**
+         * @brief Convenience wrapper: the number of connected components at every query.
+         * @complexity O(q log q log n)
+         */
+        std::vector<int> component_counts()
+        {
+            std::vector<int> res(m_queries);
+            solve([&](int q, RollbackUnionFind &dsu)
+                  { res[q] = dsu.numDisjointSets(); });
+            return res;
+        }
+    };
+}
+
+/*
+int main()
+{
+    cp::OfflineDynamicConnectivity dc(4);
+
+    dc.add_edge(0, 1);
+    dc.add_edge(2, 3);
+    dc.add_query();        // q0: {0,1} {2,3} -> 2 components
+    dc.add_edge(1, 2);
+    dc.add_query();        // q1: all connected -> 1
+    dc.remove_edge(0, 1);
+    dc.add_query();        // q2: {0} {1,2,3} -> 2
+
+    std::vector<bool> connected(3);
+    dc.solve([&](int q, RollbackUnionFind &dsu)
+             { connected[q] = dsu.isSameSet(0, 3); });
+    for (int q = 0; q < 3; ++q)
+        printf("q%d: 0~3 %s\n", q, connected[q] ? "yes" : "no"); // no, yes, no
+    return 0;
+}
+*/
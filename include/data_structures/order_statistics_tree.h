@@ -8,17 +8,21 @@
 #include <ext/pb_ds/assoc_container.hpp>
 #include <ext/pb_ds/tree_policy.hpp>
 
+// Pass cp::ArenaAllocator<char> (memory/arena.h) as Alloc to take nodes from
+// a bump arena instead of malloc; pb_ds rebinds it to its node type.
 template <
     typename Key,
     typename Value = __gnu_pbds::null_type,
-    typename Cmp_Fn = std::less<Key>>
+    typename Cmp_Fn = std::less<Key>,
+    typename Alloc = std::allocator<char>>
 
 using OrderStatisticsTree = __gnu_pbds::tree<
     Key,
     Value,
     Cmp_Fn,
     __gnu_pbds::rb_tree_tag,
-    __gnu_pbds::tree_order_statistics_node_update>;
+    __gnu_pbds::tree_order_statistics_node_update,
+    Alloc>;
 
 /*
 int main()
@@ -0,0 +1,254 @@
+#pragma once
+/*
+ * Persistent (versioned) Segment Tree over sums
+ * Operation: O(n) build(values) -> root of a new version
+ * Operation: O(log n) add(root, i, delta) -> root of a new version, O(log n) new nodes
+ * Operation: O(log n) query(root, l, r) sum over [l, r) in a given version
+ * Operation: O(log n) kth(root_l, root_r, k) k-th smallest between two versions
+ * Operation: O(1) reset() discards every version
+ */
+
+// Nodes live in one contiguous arena and refer to their children through
+// 32-bit indices instead of pointers. Node 0 is a shared, immutable empty
+// node whose children are itself, so the empty version is root 0 and an
+// update only materializes the nodes it actually touches.
+//
+// Typical use, "k-th smallest in A[l..r)": compress values to ranks, then
+// roots[i + 1] = add(roots[i], rank(A[i]), 1) and answer kth(roots[l], roots[r], k).
+//
+// The node pool takes an allocator, rebound to the node type. With
+// cp::ArenaAllocator (memory/arena.h) several trees share one bump arena,
+// and growing the pool never returns memory to malloc mid-test.
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <type_traits>
+#include <memory>
+
+namespace cp
+{
+    /**
+     * @brief A persistent segment tree of sums with arena-allocated nodes.
+     * @tparam T The numeric type of the sums (e.g., int, long long).
+     * @tparam Alloc An allocator for T, rebound to the internal node type.
+     *
+     * Every update returns the root of a new version and leaves older versions
+     * untouched. All indices are 0-based and ranges are half-open.
+     */
+    template <typename T = int, typename Alloc = std::allocator<T>>
+    class PersistentSegTree
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "Node values must be trivially destructible for O(1) reset.");
+
+    public:
+        using node_id = std::uint32_t;
+
+    private:
+        struct Node
+        {
+            T sum;
+            node_id left, right;
+        };
+
+        using node_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+
+        int m_n;
+        std::vector<Node, node_allocator> m_nodes;
+
+        node_id clone(node_id p)
+        {
+            m_nodes.push_back(m_nodes[p]);
+            return static_cast<node_id>(m_nodes.size() - 1);
+        }
+
+        node_id build(const std::vector<T> &values, int lo, int hi)
+        {
+            node_id p = clone(0);
+            if (hi - lo == 1)
+            {
+                m_nodes[p].sum = values[lo];
+                return p;
+            }
+            int mid = (lo + hi) / 2;
+            node_id l = build(values, lo, mid);
+            node_id r = build(values, mid, hi);
+            m_nodes[p] = {m_nodes[l].sum + m_nodes[r].sum, l, r};
+            return p;
+        }
+
+    public:
+        /**
+         * @brief Constructs an empty arena for positions [0, n).
+         * @param n The number of positions (n >= 1).
+         * @param reserve_nodes Number of nodes to pre-allocate. Each `add`
+         *        creates at most bit_width(n - 1) + 1 nodes, `build` about 2n.
+         */
+        explicit PersistentSegTree(int n, size_t reserve_nodes = 0, const Alloc &alloc = Alloc())
+            : m_n(n), m_nodes(node_allocator(alloc))
+        {
+            assert(n >= 1);
+            m_nodes.reserve(reserve_nodes + 1);
+            m_nodes.push_back({T(0), 0, 0});
+        }
+
+        /// @brief The root of the all-zero version, which always exists.
+        static constexpr node_id empty_root() { return 0; }
+
+        /**
+         * @brief Creates a version holding the given values.
+         * @param values A vector of exactly n initial values.
+         * @return The root of the new version.
+         * @complexity O(n)
+         */
+        node_id build(const std::vector<T> &values)
+        {
+            assert(static_cast<int>(values.size()) == m_n);
+            return build(values, 0, m_n);
+        }
+
+        /**
+         * @brief Adds delta at position i on top of the version rooted at `root`.
+         * @return The root of the new version.
+         * @complexity O(log n) time and new nodes.
+         */
+        node_id add(node_id root, int i, T delta)
+        {
+            assert(0 <= i && i < m_n);
+            node_id new_root = clone(root), cur = new_root;
+            int lo = 0, hi = m_n;
+            while (true)
+            {
+                m_nodes[cur].sum += delta;
+                if (hi - lo == 1)
+                    break;
+                int mid = (lo + hi) / 2;
+                if (i < mid)
+                {
+                    node_id child = clone(m_nodes[cur].left);
+                    m_nodes[cur].left = child;
+                    cur = child, hi = mid;
+                }
+                else
+                {
+                    node_id child = clone(m_nodes[cur].right);
+                    m_nodes[cur].right = child;
+                    cur = child, lo = mid;
+                }
+            }
+            return new_root;
+        }
+
+        /**
+         * @brief Calculates the sum of positions [0, r) in a version.
+         * @complexity O(log n)
+         */
+        T prefix(node_id root, int r) const
+        {
+            assert(0 <= r && r <= m_n);
+            T res = T(0);
+            int lo = 0, hi = m_n;
+            for (node_id cur = root; cur != 0 && r > lo;)
+            {
+                if (r >= hi)
+                {
+                    res += m_nodes[cur].sum;
+                    break;
+                }
+                int mid = (lo + hi) / 2;
+                if (r <= mid)
+                {
+                    cur = m_nodes[cur].left, hi = mid;
+                }
+                else
+                {
+                    res += m_nodes[m_nodes[cur].left].sum;
+                    cur = m_nodes[cur].right, lo = mid;
+                }
+            }
+            return res;
+        }
+
+        /**
+         * @brief Calculates the sum of positions [l, r) in a version.
+         * @complexity O(log n)
+         */
+        T query(node_id root, int l, int r) const
+        {
+            return l >= r ? T(0) : prefix(root, r) - prefix(root, l);
+        }
+
+        /// @brief Returns the value at position i in a version. O(log n).
+        T get(node_id root, int i) const { return query(root, i, i + 1); }
+
+        /// @brief Returns the total sum of a version. O(1).
+        T total(node_id root) const { return m_nodes[root].sum; }
+
+        /**
+         * @brief Finds the k-th (0-based) unit in the difference of two versions.
+         *
+         * Treats version `hi_root` minus version `lo_root` as a multiset of
+         * positions (counts must be non-negative) and returns the smallest
+         * position p such that more than k units lie in [0, p].
+         * @pre 0 <= k < total(hi_root) - total(lo_root)
+         * @complexity O(log n)
+         */
+        int kth(node_id lo_root, node_id hi_root, T k) const
+        {
+            node_id a = lo_root, b = hi_root;
+            int lo = 0, hi = m_n;
+            while (hi - lo > 1)
+            {
+                int mid = (lo + hi) / 2;
+                T left_count = m_nodes[m_nodes[b].left].sum - m_nodes[m_nodes[a].left].sum;
+                if (k < left_count)
+                {
+                    a = m_nodes[a].left, b = m_nodes[b].left, hi = mid;
+                }
+                else
+                {
+                    k -= left_count;
+                    a = m_nodes[a].right, b = m_nodes[b].right, lo = mid;
+                }
+            }
+            return lo;
+        }
+
+        /// @brief Pre-allocates room for `count` more nodes.
+        void reserve(size_t count) { m_nodes.reserve(m_nodes.size() + count); }
+
+        /**
+         * @brief Discards every version except the empty one, keeping the memory.
+         * @complexity O(1)
+         */
+        void reset() { m_nodes.resize(1); }
+
+        /// @brief Returns the number of allocated nodes, including the empty node.
+        size_t node_count() const { return m_nodes.size(); }
+
+        /// @brief Returns the number of positions (n).
+        int size() const { return m_n; }
+    };
+}
+
+/*
+int main()
+{
+    // k-th smallest in a subarray
+    std::vector<int> A = {5, 1, 4, 2, 3}; // already ranks in [1, 5]
+    int n = A.size();
+
+    cp::PersistentSegTree<int> pst(6, n * 4);
+    std::vector<cp::PersistentSegTree<int>::node_id> roots = {pst.empty_root()};
+    for (int x : A)
+        roots.push_back(pst.add(roots.back(), x, 1));
+
+    printf("%d\n", pst.kth(roots[1], roots[4], 0)); // smallest of {1, 4, 2} = 1
+    printf("%d\n", pst.kth(roots[1], roots[4], 2)); // largest of {1, 4, 2} = 4
+    printf("%d\n", pst.query(roots[3], 1, 5));      // count of values in [1, 5) among A[0..2] = 2
+
+    pst.reset(); // next test case: all versions gone, arena kept
+    return 0;
+}
+*/
@@ -26,6 +26,8 @@
 #include <bits/stdc++.h>
 using namespace std;
 
+#include "../debug/stats.h"
+
 class SegmentTree
 {
 private:
@@ -66,6 +68,7 @@ private:
     {
         if (lazy[p] != -1)
         {
+            CP_STAT("SegmentTree propagate", 1);
             st[p] = lazy[p];
             if (L != R)
                 lazy[l(p)] = lazy[r(p)] = lazy[p];
@@ -0,0 +1,281 @@
+#pragma once
+/*
+ * Static range queries (no updates)
+ * SparseTable:         O(n log n) build, O(1) query for idempotent monoids (min, max, gcd)
+ * DisjointSparseTable: O(n log n) build, O(1) query for any associative monoid (sum, product)
+ * BlockRMQ:            O(n) build and memory, O(1) range-minimum query
+ */
+
+// All tables keep their levels in a single flat vector, one contiguous row of
+// n entries per level, so a query touches exactly two entries of one row. The
+// rows are built from a std::vector with sequential sweeps only.
+//
+// BlockRMQ splits the array into 64-element blocks. Inside a block, position i
+// stores a 64-bit mask of the monotonic stack of block[0..i]; the minimum of
+// block[l..i] is then the lowest stack entry at or after l (one ctz). A sparse
+// table over the n / 64 block minima answers the full blocks in between.
+
+#include <vector>
+#include <bit>
+#include <cstdint>
+#include <cassert>
+#include <functional>
+#include <algorithm>
+
+#include "monoid.h"
+
+namespace cp
+{
+    /**
+     * @brief Sparse table for idempotent range queries.
+     * @tparam Monoid A monoid policy with combine(x, x) == x (see monoid.h).
+     *
+     * All indices are 0-based and ranges are half-open.
+     */
+    template <typename Monoid>
+    class SparseTable
+    {
+    public:
+        using T = typename Monoid::value_type;
+
+    private:
+        size_t m_n = 0;
+        /// @brief Level k occupies [k * n, (k + 1) * n) and holds prod(i, i + 2^k).
+        std::vector<T> m_table;
+
+    public:
+        SparseTable() = default;
+
+        /**
+         * @brief Builds the table from a list of values.
+         * @complexity O(n log n)
+         */
+        explicit SparseTable(const std::vector<T> &values) : m_n(values.size())
+        {
+            int levels = m_n == 0 ? 0 : std::bit_width(m_n);
+            m_table.resize(levels * m_n);
+            std::copy(values.begin(), values.end(), m_table.begin());
+            for (int k = 1; k < levels; ++k)
+            {
+                const T *prev = m_table.data() + (k - 1) * m_n;
+                T *cur = m_table.data() + k * m_n;
+                size_t half = size_t(1) << (k - 1);
+                for (size_t i = 0; i + 2 * half <= m_n; ++i)
+                    cur[i] = Monoid::combine(prev[i], prev[i + half]);
+            }
+        }
+
+        /**
+         * @brief Combines the elements in [l, r), or returns the identity if l == r.
+         * @complexity O(1)
+         */
+        T query(size_t l, size_t r) const
+        {
+            assert(l <= r && r <= m_n);
+            if (l == r)
+                return Monoid::identity();
+            int k = std::bit_width(r - l) - 1;
+            const T *row = m_table.data() + k * m_n;
+            return Monoid::combine(row[l], row[r - (size_t(1) << k)]);
+        }
+
+        size_t size() const { return m_n; }
+    };
+
+    /**
+     * @brief Disjoint sparse table for range queries over any associative monoid.
+     * @tparam Monoid A monoid policy (see monoid.h); need not be idempotent or commutative.
+     *
+     * All indices are 0-based and ranges are half-open.
+     */
+    template <typename Monoid>
+    class DisjointSparseTable
+    {
+    public:
+        using T = typename Monoid::value_type;
+
+    private:
+        size_t m_n = 0, m_size = 1;
+        /**
+         * @brief Level 0 holds the values. In level h >= 1, blocks of 2^h are split at
+         * their middle m: entry i < m holds prod(i, m) and entry i >= m holds prod(m, i + 1).
+         */
+        std::vector<T> m_table;
+
+    public:
+        DisjointSparseTable() = default;
+
+        /**
+         * @brief Builds the table from a list of values.
+         * @complexity O(n log n)
+         */
+        explicit DisjointSparseTable(const std::vector<T> &values)
+            : m_n(values.size()), m_size(std::bit_ceil(values.size() | 1))
+        {
+            int levels = std::countr_zero(m_size) + 1;
+            m_table.assign(levels * m_size, Monoid::identity());
+            std::copy(values.begin(), values.end(), m_table.begin());
+            const T *a = m_table.data();
+            for (int h = 1; h < levels; ++h)
+            {
+                T *row = m_table.data() + h * m_size;
+                size_t half = size_t(1) << (h - 1);
+                for (size_t mid = half; mid < m_size; mid += 2 * half)
+                {
+                    row[mid - 1] = a[mid - 1];
+                    for (size_t i = mid - 1; i > mid - half; --i)
+                        row[i - 1] = Monoid::combine(a[i - 1], row[i]);
+                    row[mid] = a[mid];
+                    for (size_t i = mid + 1; i < mid + half; ++i)
+                        row[i] = Monoid::combine(row[i - 1], a[i]);
+                }
+            }
+        }
+
+        /**
+         * @brief Combines the elements in [l, r), or returns the identity if l == r.
+         * @complexity O(1)
+         */
+        T query(size_t l, size_t r) const
+        {
+            assert(l <= r && r <= m_n);
+            if (l == r)
+                return Monoid::identity();
+            size_t last = r - 1;
+            if (l == last)
+                return m_table[l];
+            const T *row = m_table.data() + std::bit_width(l ^ last) * m_size;
+            return Monoid::combine(row[l], row[last]);
+        }
+
+        size_t size() const { return m_n; }
+    };
+
+    /**
+     * @brief Range-minimum queries in O(n) memory and O(1) time.
+     * @tparam T The element type.
+     * @tparam Compare A strict weak ordering; std::greater<T> gives range maximum.
+     *
+     * Ties resolve to the leftmost position. All indices are 0-based and ranges
+     * are half-open.
+     */
+    template <typename T, typename Compare = std::less<T>>
+    class BlockRMQ
+    {
+    private:
+        static constexpr int B = 64;
+
+        std::vector<T> m_values;
+        /// @brief Bit j of m_masks[i] is set if block position j is on the monotonic stack of block[0..i].
+        std::vector<std::uint64_t> m_masks;
+        size_t m_blocks = 0;
+        /// @brief Sparse table of argmin positions over whole blocks, one row of m_blocks per level.
+        std::vector<std::uint32_t> m_table;
+        Compare m_less;
+
+        std::uint32_t better(std::uint32_t i, std::uint32_t j) const
+        {
+            return m_less(m_values[j], m_values[i]) ? j : i;
+        }
+
+        /// @brief Argmin of [l, r] (inclusive) within one block.
+        std::uint32_t in_block(size_t l, size_t r) const
+        {
+            std::uint64_t mask = m_masks[r] & (~std::uint64_t(0) << (l % B));
+            return static_cast<std::uint32_t>(r - r % B + std::countr_zero(mask));
+        }
+
+    public:
+        BlockRMQ() = default;
+
+        /**
+         * @brief Builds the structure from a list of values.
+         * @complexity O(n)
+         */
+        explicit BlockRMQ(const std::vector<T> &values, Compare less = Compare())
+            : m_values(values), m_masks(values.size()), m_less(less)
+        {
+            size_t n = m_values.size();
+            m_blocks = (n + B - 1) / B;
+
+            std::uint32_t stack[B];
+            for (size_t start = 0; start < n; start += B)
+            {
+                int top = 0;
+                std::uint64_t mask = 0;
+                for (size_t i = start; i < n && i < start + B; ++i)
+                {
+                    while (top > 0 && m_less(m_values[i], m_values[stack[top - 1]]))
+                        mask ^= std::uint64_t(1) << (stack[--top] - start);
+                    stack[top++] = static_cast<std::uint32_t>(i);
+                    mask |= std::uint64_t(1) << (i - start);
+                    m_masks[i] = mask;
+                }
+            }
+
+            int levels = m_blocks == 0 ? 0 : std::bit_width(m_blocks);
+            m_table.resize(levels * m_blocks);
+            for (size_t b = 0; b < m_blocks; ++b)
+                m_table[b] = in_block(b * B, std::min(n, (b + 1) * B) - 1);
+            for (int k = 1; k < levels; ++k)
+            {
+                const std::uint32_t *prev = m_table.data() + (k - 1) * m_blocks;
+                std::uint32_t *cur = m_table.data() + k * m_blocks;
+                size_t half = size_t(1) << (k - 1);
+                for (size_t i = 0; i + 2 * half <= m_blocks; ++i)
+                    cur[i] = better(prev[i], prev[i + half]);
+            }
+        }
+
+        /**
+         * @brief Returns the position of the minimum in [l, r).
+         * @pre l < r
+         * @complexity O(1)
+         */
+        size_t argmin(size_t l, size_t r) const
+        {
+            assert(l < r && r <= m_values.size());
+            size_t last = r - 1, bl = l / B, br = last / B;
+            if (bl == br)
+                return in_block(l, last);
+
+            std::uint32_t best = in_block(l, bl * B + B - 1);
+            if (bl + 1 < br)
+            {
+                int k = std::bit_width(br - bl - 1) - 1;
+                const std::uint32_t *row = m_table.data() + k * m_blocks;
+                best = better(best, better(row[bl + 1], row[br - (size_t(1) << k)]));
+            }
+            return better(best, in_block(br * B, last));
+        }
+
+        /**
+         * @brief Returns the minimum of [l, r).
+         * @pre l < r
+         * @complexity O(1)
+         */
+        const T &query(size_t l, size_t r) const { return m_values[argmin(l, r)]; }
+
+        size_t size() const { return m_values.size(); }
+    };
+}
+
+/*
+int main()
+{
+    std::vector<int> A = {18, 17, 13, 19, 15, 11, 20, 99};
+
+    cp::SparseTable<cp::monoid::Min<int>> st(A);
+    printf("min[1, 4) = %d\n", st.query(1, 4)); // 13
+
+    cp::DisjointSparseTable<cp::monoid::Sum<long long>> dst(std::vector<long long>(A.begin(), A.end()));
+    printf("sum[4, 8) = %lld\n", dst.query(4, 8)); // 145
+
+    cp::BlockRMQ<int> rmq(A);
+    printf("min[3, 8) = %d at %zu\n", rmq.query(3, 8), rmq.argmin(3, 8)); // 11 at 5
+
+    cp::BlockRMQ<int, std::greater<int>> rmaxq(A);
+    printf("max[0, 7) = %d\n", rmaxq.query(0, 7)); // 20
+    return 0;
+}
+*/
@@ -4,8 +4,15 @@
  * UFDS Operation: O(1) findSet(i)
  * UFDS Operation: O(1) isSameSet(i, j)
  * UFDS Operation: O(1) unionSet(i, j)
+ * Variants: UnionFind (union by rank, recursive path compression)
+ *           CompactUnionFind (single int32 array, union by size, path halving)
+ *           RollbackUnionFind (union by size, O(log n) findSet, O(1) undo per union)
  */
 #include <vector>
+#include <cstdint>
+#include <utility>
+
+#include "../debug/stats.h"
 
 class UnionFind
 {
@@ -13,6 +20,17 @@ private:
     std::vector<int> p, rank, setSize;
     int numSets;
 
+    /// @brief findSet that also carries the number of parent hops taken so far.
+    int findSet(int i, int hops)
+    {
+        if (p[i] == i)
+        {
+            CP_STAT("UnionFind findSet", hops);
+            return i;
+        }
+        return p[i] = findSet(p[i], hops + 1);
+    }
+
 public:
     UnionFind(int N)
     {
@@ -26,10 +44,7 @@ public:
         numSets = N;
     }
 
-    int findSet(int i)
-    {
-        return (p[i] == i) ? i : (p[i] = findSet(p[i]));
-    }
+    int findSet(int i) { return findSet(i, 0); }
 
     bool isSameSet(int i, int j)
     {
@@ -70,6 +85,151 @@ public:
     }
 };
 
+// Compact variant: a single int32 array where p[i] is the parent of i, or
+// -(size of the set) if i is a root. One array instead of three keeps the
+// footprint at 4 bytes per element, findSet uses iterative path halving (no
+// recursion, so no stack overflow on long chains), and the union is by size.
+class CompactUnionFind
+{
+private:
+    std::vector<int32_t> p;
+    int numSets;
+
+public:
+    CompactUnionFind(int N) : p(N, -1), numSets(N) {}
+
+    int findSet(int i)
+    {
+        [[maybe_unused]] int hops = 0;
+        while (p[i] >= 0)
+        {
+            ++hops;
+            if (p[p[i]] >= 0)
+            {
+                p[i] = p[p[i]];
+            }
+            i = p[i];
+        }
+        CP_STAT("CompactUnionFind findSet", hops);
+        return i;
+    }
+
+    bool isSameSet(int i, int j)
+    {
+        return findSet(i) == findSet(j);
+    }
+
+    int numDisjointSets()
+    {
+        return numSets;
+    }
+
+    int sizeOfSet(int i)
+    {
+        return -p[findSet(i)];
+    }
+
+    // Returns true if i and j were in different sets and have been merged.
+    bool unionSet(int i, int j)
+    {
+        int x = findSet(i), y = findSet(j);
+        if (x == y)
+        {
+            return false;
+        }
+
+        if (p[x] > p[y])
+        {
+            std::swap(x, y);
+        }
+
+        p[x] += p[y];
+        p[y] = x;
+        --numSets;
+        return true;
+    }
+};
+
+// Rollback variant: union by size without path compression, so findSet is
+// O(log n) and every union can be undone. Each successful unionSet pushes one
+// entry on an operation stack; snapshot() returns the current stack height and
+// rollback(to) undoes unions in LIFO order until the stack is back at `to`.
+class RollbackUnionFind
+{
+private:
+    std::vector<int32_t> p;
+    std::vector<std::pair<int, int>> history; // (absorbed root, its old p value)
+    int numSets;
+
+public:
+    RollbackUnionFind(int N) : p(N, -1), numSets(N) {}
+
+    int findSet(int i)
+    {
+        [[maybe_unused]] int hops = 0;
+        while (p[i] >= 0)
+        {
+            ++hops;
+            i = p[i];
+        }
+        CP_STAT("RollbackUnionFind findSet", hops);
+        return i;
+    }
+
+    bool isSameSet(int i, int j)
+    {
+        return findSet(i) == findSet(j);
+    }
+
+    int numDisjointSets()
+    {
+        return numSets;
+    }
+
+    int sizeOfSet(int i)
+    {
+        return -p[findSet(i)];
+    }
+
+    // Returns true if i and j were in different sets and have been merged.
+    bool unionSet(int i, int j)
+    {
+        int x = findSet(i), y = findSet(j);
+        if (x == y)
+        {
+            return false;
+        }
+
+        if (p[x] > p[y])
+        {
+            std::swap(x, y);
+        }
+
+        history.emplace_back(y, p[y]);
+        p[x] += p[y];
+        p[y] = x;
+        --numSets;
+        return true;
+    }
+
+    int snapshot() const
+    {
+        return static_cast<int>(history.size());
+    }
+
+    void rollback(int to)
+    {
+        while (static_cast<int>(history.size()) > to)
+        {
+            auto [y, old] = history.back();
+            history.pop_back();
+            p[p[y]] -= old;
+            p[y] = old;
+            ++numSets;
+        }
+    }
+};
+
 /*
 int main()
 {
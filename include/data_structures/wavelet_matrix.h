@@ -0,0 +1,320 @@
+#pragma once
+/*
+ * Wavelet Matrix over a static array of non-negative integers
+ * Operation: O(n log sigma) build(values)
+ * Operation: O(log sigma) access(i)
+ * Operation: O(log sigma) kth_smallest(l, r, k), kth_largest(l, r, k)
+ * Operation: O(log sigma) rank(l, r, x)           occurrences of x in [l, r)
+ * Operation: O(log sigma) count_less(l, r, x)     values < x in [l, r)
+ * Operation: O(log sigma) range_freq(l, r, lo, hi) values in [lo, hi) within [l, r)
+ * Operation: O(log sigma) prev_value(l, r, x), next_value(l, r, x)
+ */
+
+// Level b (from the top bit down) stores bit b of every value, in the order
+// left by a stable partition on the higher bits: all values with bit b = 0 of
+// the level above come first, then those with bit b = 1. A query range maps to
+// one range per level through two rank() calls, so every query is a single
+// top-down walk with no pointers.
+//
+// Each level is a BitVector: 64-bit words plus the number of ones before each
+// word, so rank() is one lookup and one popcount. Memory is 1.5 n bits per
+// level, n log sigma * 1.5 bits in total.
+//
+// Values must be in [0, 2^63); compress larger or negative keys with
+// CoordinateCompressor (coordinate_compressor.h) first. All indices are
+// 0-based and ranges are half-open.
+
+#include <vector>
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <algorithm>
+#include <type_traits>
+
+namespace cp
+{
+    /**
+     * @brief A static bit array with O(1) rank.
+     */
+    class BitVector
+    {
+    private:
+        std::vector<std::uint64_t> m_words;
+        /// @brief m_before[w] is the number of ones in words [0, w).
+        std::vector<std::uint32_t> m_before;
+
+    public:
+        BitVector() = default;
+
+        explicit BitVector(size_t n) : m_words(n / 64 + 1, 0), m_before(n / 64 + 1, 0) {}
+
+        void set(size_t i) { m_words[i >> 6] |= std::uint64_t(1) << (i & 63); }
+
+        bool get(size_t i) const { return (m_words[i >> 6] >> (i & 63)) & 1; }
+
+        /// @brief Computes the cumulative counts. Call once after the last set().
+        void build()
+        {
+            std::uint32_t ones = 0;
+            for (size_t w = 0; w < m_words.size(); ++w)
+            {
+                m_before[w] = ones;
+                ones += std::popcount(m_words[w]);
+            }
+        }
+
+        /// @brief Returns the number of ones in [0, i).
+        size_t rank1(size_t i) const
+        {
+            return m_before[i >> 6] + std::popcount(m_words[i >> 6] & ((std::uint64_t(1) << (i & 63)) - 1));
+        }
+
+        /// @brief Returns the number of zeros in [0, i).
+        size_t rank0(size_t i) const { return i - rank1(i); }
+    };
+
+    /**
+     * @brief A wavelet matrix answering order-statistic queries on subarrays.
+     * @tparam T An integral value type; stored values must be non-negative.
+     */
+    template <typename T = int>
+    class WaveletMatrix
+    {
+        static_assert(std::is_integral_v<T>, "WaveletMatrix stores integers.");
+
+    private:
+        using U = std::make_unsigned_t<T>;
+
+        size_t m_n = 0;
+        int m_bits = 0;
+        /// @brief m_levels[0] holds the highest bit.
+        std::vector<BitVector> m_levels;
+        /// @brief The number of zeros on each level: where the ones' range starts below.
+        std::vector<size_t> m_zeros;
+
+        U bit_of(int level) const { return U(1) << (m_bits - 1 - level); }
+
+        static constexpr bool negative(T v)
+        {
+            if constexpr (std::is_signed_v<T>)
+                return v < 0;
+            else
+                return false;
+        }
+
+        /// @brief Whether v has a bit above the stored ones (so it exceeds every value).
+        bool too_wide(T v) const { return static_cast<int>(std::bit_width(static_cast<U>(v))) > m_bits; }
+
+        /// @brief Values in [l, r) that are < x, for 0 <= x < 2^bits.
+        size_t count_less_bits(size_t l, size_t r, U x) const
+        {
+            size_t less = 0;
+            for (int lv = 0; lv < m_bits && l < r; ++lv)
+            {
+                const BitVector &bv = m_levels[lv];
+                size_t l1 = bv.rank1(l), r1 = bv.rank1(r);
+                if (x & bit_of(lv))
+                {
+                    less += (r - l) - (r1 - l1);
+                    l = m_zeros[lv] + l1, r = m_zeros[lv] + r1;
+                }
+                else
+                {
+                    l -= l1, r -= r1;
+                }
+            }
+            return less;
+        }
+
+    public:
+        WaveletMatrix() = default;
+
+        /// @brief Builds the matrix. O(n log sigma).
+        explicit WaveletMatrix(const std::vector<T> &values) { build(values); }
+
+        /**
+         * @brief Re-initializes from `values`, all in [0, 2^63).
+         * @complexity O(n log sigma) time, O(n) extra memory during the build.
+         */
+        void build(const std::vector<T> &values)
+        {
+            m_n = values.size();
+            U max_value = 0;
+            for (T v : values)
+            {
+                assert(!negative(v));
+                max_value = std::max(max_value, static_cast<U>(v));
+            }
+            m_bits = std::max(1, static_cast<int>(std::bit_width(max_value)));
+            m_levels.assign(m_bits, BitVector(m_n));
+            m_zeros.assign(m_bits, 0);
+
+            std::vector<U> cur(values.begin(), values.end()), next(m_n);
+            for (int lv = 0; lv < m_bits; ++lv)
+            {
+                U bit = bit_of(lv);
+                BitVector &bv = m_levels[lv];
+                size_t zeros = 0;
+                for (size_t i = 0; i < m_n; ++i)
+                {
+                    if (cur[i] & bit)
+                        bv.set(i);
+                    else
+                        ++zeros;
+                }
+                bv.build();
+                m_zeros[lv] = zeros;
+                // Stable partition: zeros first, then ones.
+                size_t z = 0, o = zeros;
+                for (size_t i = 0; i < m_n; ++i)
+                    next[(cur[i] & bit) ? o++ : z++] = cur[i];
+                cur.swap(next);
+            }
+        }
+
+        /// @brief Returns values[i]. O(log sigma).
+        T access(size_t i) const
+        {
+            assert(i < m_n);
+            U v = 0;
+            for (int lv = 0; lv < m_bits; ++lv)
+            {
+                const BitVector &bv = m_levels[lv];
+                if (bv.get(i))
+                {
+                    v |= bit_of(lv);
+                    i = m_zeros[lv] + bv.rank1(i);
+                }
+                else
+                {
+                    i = bv.rank0(i);
+                }
+            }
+            return static_cast<T>(v);
+        }
+
+        T operator[](size_t i) const { return access(i); }
+
+        /**
+         * @brief Returns the k-th smallest (0-based) value in [l, r).
+         * @pre 0 <= k < r - l
+         * @complexity O(log sigma)
+         */
+        T kth_smallest(size_t l, size_t r, size_t k) const
+        {
+            assert(l <= r && r <= m_n && k < r - l);
+            U v = 0;
+            for (int lv = 0; lv < m_bits; ++lv)
+            {
+                const BitVector &bv = m_levels[lv];
+                size_t l1 = bv.rank1(l), r1 = bv.rank1(r);
+                size_t zeros = (r - l) - (r1 - l1);
+                if (k < zeros)
+                {
+                    l -= l1, r -= r1;
+                }
+                else
+                {
+                    k -= zeros;
+                    v |= bit_of(lv);
+                    l = m_zeros[lv] + l1, r = m_zeros[lv] + r1;
+                }
+            }
+            return static_cast<T>(v);
+        }
+
+        /// @brief Returns the k-th largest (0-based) value in [l, r). O(log sigma).
+        T kth_largest(size_t l, size_t r, size_t k) const
+        {
+            assert(k < r - l);
+            return kth_smallest(l, r, r - l - 1 - k);
+        }
+
+        /**
+         * @brief Counts the values in [l, r) strictly less than x.
+         * @complexity O(log sigma)
+         */
+        size_t count_less(size_t l, size_t r, T x) const
+        {
+            assert(l <= r && r <= m_n);
+            if (negative(x) || x == 0)
+                return 0;
+            if (too_wide(x))
+                return r - l;
+            return count_less_bits(l, r, static_cast<U>(x));
+        }
+
+        /**
+         * @brief Counts the values in [l, r) that lie in [lo, hi).
+         * @complexity O(log sigma)
+         */
+        size_t range_freq(size_t l, size_t r, T lo, T hi) const
+        {
+            if (lo >= hi)
+                return 0;
+            return count_less(l, r, hi) - count_less(l, r, lo);
+        }
+
+        /**
+         * @brief Counts the occurrences of x in [l, r).
+         * @complexity O(log sigma)
+         */
+        size_t rank(size_t l, size_t r, T x) const
+        {
+            assert(l <= r && r <= m_n);
+            if (negative(x) || too_wide(x))
+                return 0;
+            for (int lv = 0; lv < m_bits && l < r; ++lv)
+            {
+                const BitVector &bv = m_levels[lv];
+                if (static_cast<U>(x) & bit_of(lv))
+                    l = m_zeros[lv] + bv.rank1(l), r = m_zeros[lv] + bv.rank1(r);
+                else
+                    l = bv.rank0(l), r = bv.rank0(r);
+            }
+            return r - l;
+        }
+
+        /// @brief Counts the occurrences of x in the whole array. O(log sigma).
+        size_t rank(T x) const { return rank(0, m_n, x); }
+
+        /**
+         * @brief Returns the largest value < x in [l, r), or `none` if there is none.
+         * @complexity O(log sigma)
+         */
+        T prev_value(size_t l, size_t r, T x, T none = -1) const
+        {
+            size_t less = count_less(l, r, x);
+            return less == 0 ? none : kth_smallest(l, r, less - 1);
+        }
+
+        /**
+         * @brief Returns the smallest value >= x in [l, r), or `none` if there is none.
+         * @complexity O(log sigma)
+         */
+        T next_value(size_t l, size_t r, T x, T none = -1) const
+        {
+            size_t less = count_less(l, r, x);
+            return less == r - l ? none : kth_smallest(l, r, less);
+        }
+
+        size_t size() const { return m_n; }
+    };
+}
+
+/*
+int main()
+{
+    std::vector<int> A = {5, 1, 4, 2, 3, 1, 5, 0};
+    cp::WaveletMatrix<int> wm(A);
+
+    printf("%d\n", wm.kth_smallest(1, 4, 0));     // smallest of {1, 4, 2} = 1
+    printf("%d\n", wm.kth_smallest(1, 4, 2));     // largest of {1, 4, 2} = 4
+    printf("%zu\n", wm.count_less(0, 8, 3));      // {1, 2, 1, 0} = 4
+    printf("%zu\n", wm.range_freq(0, 5, 2, 5));   // {4, 2, 3} = 3
+    printf("%zu\n", wm.rank(0, 8, 5));            // 2
+    printf("%d %d\n", wm.prev_value(2, 6, 4), wm.next_value(2, 6, 4)); // 3 4
+    return 0;
+}
+*/
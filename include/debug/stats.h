@@ -0,0 +1,167 @@
+#pragma once
+/*
+ * Opt-in instrumentation counters (compile with -DCP_INSTRUMENT)
+ * CP_STAT(name, value)       one event of size value: events += 1, total += value, max updated
+ * CP_STAT_ADD(name, value)   total += value without an event (e.g. one hop of a recursive walk)
+ * cp::stats::dump(out)       prints every counter; called automatically at exit
+ * cp::stats::reset()         zeroes every counter
+ */
+
+// Without CP_INSTRUMENT both macros expand to ((void)0), their arguments are
+// never evaluated, and dump() / reset() are empty: production builds pay
+// nothing. With it, each call site binds its counter once (a function-local
+// static, so the hot path is one guard check and relaxed atomic adds) and
+// counters with the same name are merged. The macros are safe to use inside
+// constexpr functions; they only count at run time.
+//
+// The instrumented structures report:
+//   UnionFind / CompactUnionFind / RollbackUnionFind findSet   parent hops per call
+//   HashTable probe, FlatHashMap probe                        keys compared / slots probed per lookup
+//   SegmentTree propagate, LazySegTree push                   push-downs of pending tags
+//   Zn::power, MontZn::power                                  calls, total and max exponent bits
+//   Arena bytes, AlignedAllocator bytes                       bytes handed out per allocation
+//
+// The report goes to stderr so that stdout stays comparable with the
+// expected output. mean is total / events and max is the largest CP_STAT value
+// (the longest find path, the worst lookup); CP_STAT_ADD raises total only.
+
+#include <cstdio>
+#include <type_traits>
+
+#ifdef CP_INSTRUMENT
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace cp::stats
+{
+    /**
+     * @brief One named counter: the number of events, the sum and the maximum of their values.
+     */
+    struct Counter
+    {
+        std::atomic<std::uint64_t> events{0}, total{0}, max{0};
+
+        void record(std::uint64_t value)
+        {
+            events.fetch_add(1, std::memory_order_relaxed);
+            total.fetch_add(value, std::memory_order_relaxed);
+            std::uint64_t seen = max.load(std::memory_order_relaxed);
+            while (value > seen && !max.compare_exchange_weak(seen, value, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        void add(std::uint64_t value) { total.fetch_add(value, std::memory_order_relaxed); }
+
+        void reset()
+        {
+            events.store(0, std::memory_order_relaxed);
+            total.store(0, std::memory_order_relaxed);
+            max.store(0, std::memory_order_relaxed);
+        }
+    };
+
+    namespace detail
+    {
+        inline void print(std::FILE *out);
+
+        /// @brief Every counter by name; prints the report when destroyed at exit.
+        struct Registry
+        {
+            std::mutex lock;
+            std::map<std::string, Counter> counters; // node-based: references stay valid
+
+            ~Registry() { print(stderr); }
+        };
+
+        inline Registry &registry()
+        {
+            static Registry r;
+            return r;
+        }
+
+        inline void print(std::FILE *out)
+        {
+            Registry &r = registry();
+            std::lock_guard guard(r.lock);
+            std::fprintf(out, "%-40s %14s %16s %12s %12s\n", "cp::stats", "events", "total", "mean", "max");
+            for (const auto &[name, c] : r.counters)
+            {
+                std::uint64_t events = c.events.load(std::memory_order_relaxed);
+                std::uint64_t total = c.total.load(std::memory_order_relaxed);
+                if (events == 0 && total == 0)
+                    continue;
+                std::fprintf(out, "%-40s %14llu %16llu %12.3f %12llu\n", name.c_str(), static_cast<unsigned long long>(events),
+                             static_cast<unsigned long long>(total), events ? static_cast<double>(total) / events : 0.0,
+                             static_cast<unsigned long long>(c.max.load(std::memory_order_relaxed)));
+            }
+            std::fflush(out);
+        }
+    }
+
+    /// @brief Returns the counter with the given name, creating it on first use.
+    inline Counter &counter(const char *name)
+    {
+        detail::Registry &r = detail::registry();
+        std::lock_guard guard(r.lock);
+        return r.counters[name];
+    }
+
+    /// @brief Prints every counter that has counted anything to `out`.
+    inline void dump(std::FILE *out = stderr) { detail::print(out); }
+
+    /// @brief Zeroes every counter, e.g. to measure only the phase after setup.
+    inline void reset()
+    {
+        detail::Registry &r = detail::registry();
+        std::lock_guard guard(r.lock);
+        for (auto &[name, c] : r.counters)
+            c.reset();
+    }
+}
+
+#define CP_STAT_SITE(name) ([]() -> ::cp::stats::Counter & { static ::cp::stats::Counter &site = ::cp::stats::counter(name); return site; }())
+
+#define CP_STAT(name, value)                                  \
+    do                                                        \
+    {                                                         \
+        if (!std::is_constant_evaluated())                    \
+            CP_STAT_SITE(name).record(static_cast<std::uint64_t>(value)); \
+    } while (0)
+
+#define CP_STAT_ADD(name, value)                              \
+    do                                                        \
+    {                                                         \
+        if (!std::is_constant_evaluated())                    \
+            CP_STAT_SITE(name).add(static_cast<std::uint64_t>(value)); \
+    } while (0)
+
+#else
+
+namespace cp::stats
+{
+    inline void dump(std::FILE * = stderr) {}
+    inline void reset() {}
+}
+
+#define CP_STAT(name, value) ((void)0)
+#define CP_STAT_ADD(name, value) ((void)0)
+
+#endif
+
+/*
+int main()
+{
+    // g++ -DCP_INSTRUMENT main.cpp
+    UnionFind uf(1 << 20);                   // union_find.h
+    for (int i = 0; i + 1 < (1 << 20); ++i)
+        uf.unionSet(i, i + 1);
+    cp::stats::reset();                      // only count the queries
+    for (int i = 0; i < (1 << 20); ++i)
+        uf.findSet(i);
+    return 0;                                // "UnionFind findSet" is printed to stderr at exit
+}
+*/
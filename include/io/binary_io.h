@@ -0,0 +1,359 @@
+#pragma once
+/*
+ * Binary snapshots of NDArrays and Fenwick trees
+ * Operation: O(n) save(path, array), save(path, fenwick)
+ * Operation: O(1) load_mmap<T>(path)   zero-copy, read-only
+ * Operation: O(n) load<T>(path), load_fenwick<T>(path)
+ */
+
+// File layout (native byte order, all fields little-endian on x86):
+//
+//   offset 0   char[4]  magic "CPND"
+//          4   u32      format version (1)
+//          8   u32      dtype kind: 'b' bool, 'i' signed, 'u' unsigned, 'f' float, 'V' raw bytes
+//         12   u32      item size in bytes
+//         16   u32      ndim
+//         20   u32      reserved (0)
+//         24   u64      offset of the element buffer from the start of the file
+//         32   u64      number of elements in the buffer (may exceed the shape product)
+//         40   u64[ndim] shape
+//              i64[ndim] strides, in elements
+//              zero padding up to the buffer offset, a multiple of 64
+//
+// The buffer is written exactly as it sits in memory, row padding included, and
+// the strides say how to walk it. load_mmap() therefore maps the file and points
+// an NDArrayView<const T> at the buffer, with no parsing and no copy. Because the
+// buffer starts on a 64-byte boundary of a page-aligned mapping, the view keeps
+// the alignment of ndarray_default_allocator.
+//
+// A FenwickTree is stored as a 1-D array of its internal tree (entry 0 included),
+// so loading it is a single copy with no rebuild.
+//
+// An empty NDArray (ndim 0) is saved with no elements and loads back empty. Every
+// header field is validated against the file size before use, so a truncated or
+// corrupt file is rejected instead of mapping a view past its end.
+
+#include <array>
+#include <vector>
+#include <span>
+#include <string>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <limits>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../data_structures/ndarray.h"
+#include "../data_structures/fenwick_tree.h"
+
+namespace cp
+{
+    namespace io
+    {
+        namespace detail
+        {
+            inline constexpr std::array<char, 4> MAGIC = {'C', 'P', 'N', 'D'};
+            inline constexpr std::uint32_t VERSION = 1;
+            inline constexpr std::uint64_t ALIGN = 64;
+
+            struct Header
+            {
+                std::array<char, 4> magic;
+                std::uint32_t version;
+                std::uint32_t kind;
+                std::uint32_t itemsize;
+                std::uint32_t ndim;
+                std::uint32_t reserved;
+                std::uint64_t data_offset;
+                std::uint64_t count;
+            };
+            static_assert(sizeof(Header) == 40);
+
+            /// @brief The dtype kind character of T.
+            template <typename T>
+            constexpr std::uint32_t kind()
+            {
+                static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable elements can be saved.");
+                if constexpr (std::is_same_v<T, bool>)
+                    return 'b';
+                else if constexpr (std::is_integral_v<T>)
+                    return std::is_signed_v<T> ? 'i' : 'u';
+                else if constexpr (std::is_floating_point_v<T>)
+                    return 'f';
+                else
+                    return 'V';
+            }
+
+            inline std::uint64_t header_bytes(std::uint64_t ndim)
+            {
+                std::uint64_t raw = sizeof(Header) + ndim * (sizeof(std::uint64_t) + sizeof(std::int64_t));
+                return (raw + ALIGN - 1) / ALIGN * ALIGN;
+            }
+
+            /**
+             * @brief The number of buffer slots a view touches, from its first element.
+             *
+             * 0-dimensional views count as empty, like a default-constructed NDArray.
+             * Saturates at UINT64_MAX instead of wrapping, so corrupt shapes read
+             * from a file can only compare as too large.
+             */
+            template <typename T>
+            std::uint64_t extent(const NDArrayView<const T> &v)
+            {
+                if (v.ndim() == 0 || v.size() == 0)
+                    return 0;
+                constexpr std::uint64_t LIMIT = std::numeric_limits<std::uint64_t>::max();
+                std::uint64_t last = 0;
+                for (size_t d = 0; d < v.ndim(); ++d)
+                {
+                    if (v.strides()[d] < 0)
+                    {
+                        throw std::invalid_argument("save: negative strides are not supported.");
+                    }
+                    std::uint64_t stride = static_cast<std::uint64_t>(v.strides()[d]);
+                    std::uint64_t span = v.shape()[d] - 1;
+                    if (stride != 0 && span > (LIMIT - 1 - last) / stride)
+                        return LIMIT;
+                    last += span * stride;
+                }
+                return last + 1;
+            }
+        }
+
+        /**
+         * @brief Writes a view, strides included, to a binary file.
+         * @param path The output file; it is overwritten.
+         * @param v The view. Only the buffer span it touches is written.
+         * @complexity O(extent of v), one sequential write.
+         */
+        template <typename T>
+        void save(const std::string &path, NDArrayView<const T> v)
+        {
+            detail::Header h{detail::MAGIC, detail::VERSION, detail::kind<T>(), sizeof(T),
+                             static_cast<std::uint32_t>(v.ndim()), 0, detail::header_bytes(v.ndim()), detail::extent(v)};
+
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            if (!out)
+            {
+                throw std::runtime_error("save: cannot open " + path);
+            }
+            out.write(reinterpret_cast<const char *>(&h), sizeof(h));
+            for (size_t d = 0; d < v.ndim(); ++d)
+            {
+                std::uint64_t dim = v.shape()[d];
+                out.write(reinterpret_cast<const char *>(&dim), sizeof(dim));
+            }
+            for (size_t d = 0; d < v.ndim(); ++d)
+            {
+                std::int64_t stride = v.strides()[d];
+                out.write(reinterpret_cast<const char *>(&stride), sizeof(stride));
+            }
+            std::vector<char> pad(h.data_offset - (sizeof(h) + v.ndim() * 16), 0);
+            out.write(pad.data(), pad.size());
+            out.write(reinterpret_cast<const char *>(v.data()), h.count * sizeof(T));
+            if (!out)
+            {
+                throw std::runtime_error("save: write to " + path + " failed.");
+            }
+        }
+
+        template <typename T>
+            requires(!std::is_const_v<T>)
+        void save(const std::string &path, NDArrayView<T> v)
+        {
+            save(path, NDArrayView<const T>(v));
+        }
+
+        template <typename T, typename Alloc>
+        void save(const std::string &path, const NDArray<T, Alloc> &a)
+        {
+            save(path, a.view());
+        }
+
+        template <typename T, typename E>
+        void save(const std::string &path, const FenwickTree<T, E> &ft)
+        {
+            std::span<const T> tree = ft.snapshot();
+            save(path, NDArrayView<const T>(tree.data(), {tree.size()}));
+        }
+
+        /**
+         * @brief A read-only memory mapping of a file written by save().
+         *
+         * Owns the mapping; views obtained from it are valid while it lives.
+         */
+        template <typename T>
+        class MappedNDArray
+        {
+        private:
+            void *m_addr = nullptr;
+            size_t m_length = 0;
+            std::vector<size_t> m_shape;
+            std::vector<std::ptrdiff_t> m_strides;
+            const T *m_data = nullptr;
+
+            void unmap()
+            {
+                if (m_addr != nullptr)
+                {
+                    ::munmap(m_addr, m_length);
+                    m_addr = nullptr;
+                }
+            }
+
+            [[noreturn]] void fail(const std::string &what)
+            {
+                unmap();
+                throw std::runtime_error("load_mmap: " + what);
+            }
+
+        public:
+            /**
+             * @brief Maps `path` and validates its header against T.
+             * @complexity O(ndim); pages are read lazily on first access.
+             */
+            explicit MappedNDArray(const std::string &path)
+            {
+                int fd = ::open(path.c_str(), O_RDONLY);
+                if (fd < 0)
+                {
+                    throw std::runtime_error("load_mmap: cannot open " + path);
+                }
+                struct stat st;
+                if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(detail::Header))
+                {
+                    ::close(fd);
+                    throw std::runtime_error("load_mmap: " + path + " is not an array file.");
+                }
+                m_length = static_cast<size_t>(st.st_size);
+                void *addr = ::mmap(nullptr, m_length, PROT_READ, MAP_PRIVATE, fd, 0);
+                ::close(fd);
+                if (addr == MAP_FAILED)
+                {
+                    throw std::runtime_error("load_mmap: cannot map " + path);
+                }
+                m_addr = addr;
+
+                const char *bytes = static_cast<const char *>(m_addr);
+                detail::Header h;
+                std::memcpy(&h, bytes, sizeof(h));
+                if (h.magic != detail::MAGIC || h.version != detail::VERSION)
+                    fail(path + " is not an array file.");
+                if (h.kind != detail::kind<T>() || h.itemsize != sizeof(T))
+                    fail(path + " holds a different element type.");
+                // Every bound is checked before it is subtracted or read past: the sizes come from the file.
+                if (h.ndim > NDArrayView<const T>::MAX_DIMS || sizeof(h) + 16 * h.ndim > m_length ||
+                    h.data_offset < detail::header_bytes(h.ndim) || h.data_offset % detail::ALIGN != 0 ||
+                    h.data_offset > m_length || (m_length - h.data_offset) / sizeof(T) < h.count)
+                    fail(path + " is truncated or corrupt.");
+
+                m_shape.resize(h.ndim);
+                m_strides.resize(h.ndim);
+                for (size_t d = 0; d < h.ndim; ++d)
+                {
+                    std::uint64_t dim;
+                    std::int64_t stride;
+                    std::memcpy(&dim, bytes + sizeof(h) + 8 * d, 8);
+                    std::memcpy(&stride, bytes + sizeof(h) + 8 * (h.ndim + d), 8);
+                    if (stride < 0)
+                        fail(path + " has negative strides; save() never writes them.");
+                    m_shape[d] = static_cast<size_t>(dim);
+                    m_strides[d] = static_cast<std::ptrdiff_t>(stride);
+                }
+                m_data = reinterpret_cast<const T *>(bytes + h.data_offset);
+                if (detail::extent(view()) > h.count)
+                    fail(path + " is truncated or corrupt.");
+            }
+
+            MappedNDArray(const MappedNDArray &) = delete;
+            MappedNDArray &operator=(const MappedNDArray &) = delete;
+
+            MappedNDArray(MappedNDArray &&other) noexcept
+                : m_addr(std::exchange(other.m_addr, nullptr)), m_length(other.m_length),
+                  m_shape(std::move(other.m_shape)), m_strides(std::move(other.m_strides)), m_data(other.m_data) {}
+
+            MappedNDArray &operator=(MappedNDArray &&other) noexcept
+            {
+                if (this != &other)
+                {
+                    unmap();
+                    m_addr = std::exchange(other.m_addr, nullptr);
+                    m_length = other.m_length;
+                    m_shape = std::move(other.m_shape);
+                    m_strides = std::move(other.m_strides);
+                    m_data = other.m_data;
+                }
+                return *this;
+            }
+
+            ~MappedNDArray() { unmap(); }
+
+            /// @brief A zero-copy view of the mapped elements with the saved shape and strides.
+            NDArrayView<const T> view() const { return NDArrayView<const T>(m_data, m_shape, m_strides); }
+
+            const std::vector<size_t> &shape() const { return m_shape; }
+        };
+
+        /// @brief Maps a file written by save() read-only (see MappedNDArray).
+        template <typename T>
+        MappedNDArray<T> load_mmap(const std::string &path)
+        {
+            return MappedNDArray<T>(path);
+        }
+
+        /**
+         * @brief Reads a file written by save() into a new contiguous NDArray.
+         * @complexity O(n)
+         */
+        template <typename T>
+        NDArray<T> load(const std::string &path)
+        {
+            return load_mmap<T>(path).view().copy();
+        }
+
+        /**
+         * @brief Reads a Fenwick tree written by save(); no rebuild is done.
+         * @complexity O(N), a single copy.
+         */
+        template <typename T>
+        FenwickTree<T> load_fenwick(const std::string &path)
+        {
+            MappedNDArray<T> mapped(path);
+            auto v = mapped.view();
+            if (v.ndim() != 1 || !v.is_contiguous())
+            {
+                throw std::runtime_error("load_fenwick: " + path + " does not hold a Fenwick tree.");
+            }
+            FenwickTree<T> ft(0);
+            ft.restore(std::span<const T>(v.data(), v.size()));
+            return ft;
+        }
+    }
+}
+
+/*
+int main()
+{
+    NDArray<long long> dp({30, 30}, ndarray_padded, 0LL);
+    for (size_t i = 0; i < 30; ++i)
+        for (size_t j = 0; j < 30; ++j)
+            dp(i, j) = (i == 0 || j == 0) ? 1 : dp(i - 1, j) + dp(i, j - 1);
+    cp::io::save("dp.bin", dp);
+
+    auto table = cp::io::load_mmap<long long>("dp.bin"); // no parsing, no copy
+    std::cout << table.view()(3, 4) << std::endl;         // 35
+
+    cp::FenwickTree<long long> ft(std::vector<long long>{3, 1, 4, 1, 5});
+    cp::io::save("ft.bin", ft);
+    std::cout << cp::io::load_fenwick<long long>("ft.bin").query(4) << std::endl; // 9
+    return 0;
+}
+*/
@@ -0,0 +1,505 @@
+#pragma once
+/*
+ * Buffered bulk input/output
+ * FastReader: O(n) read(x...) for integers, chars, strings, floats, Zn, vectors and NDArrays
+ * FastWriter: O(n) write(x...), writeln(x...) for the same types
+ */
+
+// FastReader pulls stdin through fread() in large blocks and parses straight
+// out of the buffer. The bytes after the valid data are kept zero, so digit
+// loops stop on their own without a bounds check. On little-endian targets,
+// eight digits are tested and converted at once with 64-bit SWAR arithmetic
+// (a few multiplies, no per-digit branch), which covers most of a 64-bit value.
+// fread() is used rather than mmap() so pipes work as well as files. Each
+// refill asks for a whole block, and a number near the end of the buffer
+// triggers one, so reads block until the block fills or the input ends: the
+// reader is not meant for interactive problems, where the judge waits for a
+// reply before sending the next line.
+//
+// FastWriter formats integers two digits at a time from a lookup table into a
+// buffer that is flushed only when full, and on destruction. Floating-point
+// values go through std::to_chars into a reserve that is grown until the
+// result fits.
+//
+// Zn and NDArray are forward declared, so including this header does not pull
+// in zn.h or ndarray.h; their overloads only instantiate when used.
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <bit>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <charconv>
+#include <system_error>
+#include <algorithm>
+#include <type_traits>
+
+namespace cp
+{
+    template <int MOD>
+    struct Zn;
+}
+
+template <typename T, typename Alloc>
+class NDArray;
+
+namespace cp
+{
+    namespace io
+    {
+        /**
+         * @brief A buffered whitespace-separated token reader.
+         *
+         * Every read returns false (and leaves its target unspecified) once the
+         * input is exhausted; operator>> and operator bool make that chainable.
+         */
+        class FastReader
+        {
+        private:
+            static constexpr size_t SLACK = 16; // zero bytes kept after the data
+            static constexpr size_t TOKEN = 64; // numbers this long are parsed without a refill
+
+            FILE *m_file;
+            std::vector<char> m_buf;
+            char *m_pos, *m_end;
+            bool m_eof = false;
+            bool m_ok = true;
+
+            /// @brief Moves the unread bytes to the front and appends a block. Returns whether bytes were added.
+            bool refill()
+            {
+                if (m_eof)
+                    return false;
+                size_t keep = m_end - m_pos;
+                std::memmove(m_buf.data(), m_pos, keep);
+                size_t cap = m_buf.size() - SLACK;
+                size_t got = std::fread(m_buf.data() + keep, 1, cap - keep, m_file);
+                if (got == 0)
+                    m_eof = true;
+                m_pos = m_buf.data();
+                m_end = m_pos + keep + got;
+                std::memset(m_end, 0, SLACK);
+                return got > 0;
+            }
+
+            bool skip_space()
+            {
+                for (;;)
+                {
+                    while (m_pos < m_end && static_cast<unsigned char>(*m_pos) <= ' ')
+                        ++m_pos;
+                    if (m_pos < m_end)
+                        return true;
+                    if (!refill())
+                        return false;
+                }
+            }
+
+            static bool is_digit(char c) { return static_cast<unsigned char>(c - '0') < 10; }
+
+            /// @brief Whether all 8 bytes of w are ASCII digits.
+            static bool eight_digits(std::uint64_t w)
+            {
+                return (w & 0xF0F0F0F0F0F0F0F0ULL) == 0x3030303030303030ULL &&
+                       ((w + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) == 0x3030303030303030ULL;
+            }
+
+            /// @brief Converts 8 ASCII digits, loaded little-endian (first digit lowest), to their value.
+            static std::uint32_t parse_eight(std::uint64_t w)
+            {
+                w = (w & 0x0F0F0F0F0F0F0F0FULL) * 2561 >> 8;
+                w = (w & 0x00FF00FF00FF00FFULL) * 6553601 >> 16;
+                return static_cast<std::uint32_t>((w & 0x0000FFFF0000FFFFULL) * 42949672960001ULL >> 32);
+            }
+
+            template <typename U>
+            void parse_digits(U &v)
+            {
+                for (;;)
+                {
+                    if constexpr (std::endian::native == std::endian::little && sizeof(U) >= 4)
+                    {
+                        std::uint64_t w;
+                        std::memcpy(&w, m_pos, 8); // in bounds: SLACK zero bytes follow m_end
+                        while (eight_digits(w))
+                        {
+                            v = v * 100000000u + parse_eight(w);
+                            m_pos += 8;
+                            std::memcpy(&w, m_pos, 8);
+                        }
+                    }
+                    while (is_digit(*m_pos))
+                        v = v * 10 + static_cast<U>(*m_pos++ - '0');
+                    if (m_pos < m_end || !refill())
+                        return;
+                }
+            }
+
+            template <typename T>
+            bool read_integer(T &x)
+            {
+                if (!skip_space())
+                    return false;
+                if (m_end - m_pos < static_cast<std::ptrdiff_t>(TOKEN))
+                    refill();
+                using U = std::make_unsigned_t<T>;
+                bool neg = false;
+                if (*m_pos == '-' || *m_pos == '+')
+                    neg = *m_pos++ == '-';
+                if (!is_digit(*m_pos))
+                    return false;
+                U v = 0;
+                parse_digits(v);
+                x = static_cast<T>(neg ? U(0) - v : v);
+                return true;
+            }
+
+            bool read_token(std::string &s)
+            {
+                if (!skip_space())
+                    return false;
+                s.clear();
+                for (;;)
+                {
+                    char *start = m_pos;
+                    while (m_pos < m_end && static_cast<unsigned char>(*m_pos) > ' ')
+                        ++m_pos;
+                    s.append(start, m_pos);
+                    if (m_pos < m_end || !refill())
+                        return true;
+                }
+            }
+
+        public:
+            /**
+             * @brief Reads from `file` in blocks of `capacity` bytes.
+             * @complexity O(capacity) allocation; nothing is read until the first call.
+             */
+            explicit FastReader(FILE *file = stdin, size_t capacity = 1 << 16)
+                : m_file(file), m_buf(std::max<size_t>(capacity, 2 * TOKEN) + SLACK, 0)
+            {
+                m_pos = m_end = m_buf.data();
+            }
+
+            FastReader(const FastReader &) = delete;
+            FastReader &operator=(const FastReader &) = delete;
+
+            /**
+             * @brief Reads one value: an integer, char, string token or floating-point number.
+             * @return False if the input ended or the token is not a number.
+             */
+            template <typename T>
+            bool read(T &x)
+            {
+                if constexpr (std::is_same_v<T, char>)
+                {
+                    if (!skip_space())
+                        return false;
+                    x = *m_pos++;
+                    return true;
+                }
+                else if constexpr (std::is_same_v<T, bool>)
+                {
+                    int v;
+                    if (!read_integer(v))
+                        return false;
+                    x = v != 0;
+                    return true;
+                }
+                else if constexpr (std::is_integral_v<T>)
+                {
+                    return read_integer(x);
+                }
+                else if constexpr (std::is_floating_point_v<T>)
+                {
+                    std::string s;
+                    if (!read_token(s))
+                        return false;
+                    auto [end, ec] = std::from_chars(s.data(), s.data() + s.size(), x);
+                    return ec == std::errc() && end == s.data() + s.size();
+                }
+                else
+                {
+                    static_assert(std::is_same_v<T, std::string>, "FastReader cannot read this type.");
+                    return read_token(x);
+                }
+            }
+
+            /// @brief Reads an integer and reduces it modulo MOD.
+            template <int MOD>
+            bool read(Zn<MOD> &z)
+            {
+                long long v;
+                if (!read(v))
+                    return false;
+                z = Zn<MOD>(v);
+                return true;
+            }
+
+            /// @brief Fills every element of a pre-sized vector.
+            template <typename T, typename A>
+            bool read(std::vector<T, A> &v)
+            {
+                for (auto &x : v)
+                {
+                    if (!read(x))
+                        return false;
+                }
+                return true;
+            }
+
+            /// @brief Fills every element of an array in row-major order.
+            template <typename T, typename A>
+            bool read(::NDArray<T, A> &a)
+            {
+                bool ok = true;
+                a.view().for_each([this, &ok](T &x)
+                                  { ok = ok && read(x); });
+                return ok;
+            }
+
+            template <typename T, typename U, typename... Rest>
+            bool read(T &x, U &y, Rest &...rest)
+            {
+                return read(x) && read(y) && (read(rest) && ...);
+            }
+
+            /// @brief Reads and returns one value of type T.
+            template <typename T>
+            T next()
+            {
+                T x{};
+                m_ok = read(x) && m_ok;
+                return x;
+            }
+
+            template <typename T>
+            FastReader &operator>>(T &x)
+            {
+                m_ok = m_ok && read(x);
+                return *this;
+            }
+
+            /// @brief False once a read through operator>> or next() has failed.
+            explicit operator bool() const { return m_ok; }
+        };
+
+        /**
+         * @brief A buffered writer, flushed when full and on destruction.
+         */
+        class FastWriter
+        {
+        private:
+            FILE *m_file;
+            std::vector<char> m_buf;
+            size_t m_len = 0;
+
+            static constexpr char DIGIT_PAIRS[201] =
+                "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+                "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+                "8081828384858687888990919293949596979899";
+
+            char *reserve(size_t n)
+            {
+                if (m_len + n > m_buf.size())
+                {
+                    flush();
+                    if (n > m_buf.size())
+                        m_buf.resize(n);
+                }
+                return m_buf.data() + m_len;
+            }
+
+            template <typename T>
+            void write_integer(T x)
+            {
+                using U = std::make_unsigned_t<T>;
+                char tmp[24];
+                char *end = tmp + sizeof(tmp), *p = end;
+                U v = static_cast<U>(x);
+                bool neg = false;
+                if constexpr (std::is_signed_v<T>)
+                {
+                    if (x < 0)
+                        neg = true, v = U(0) - v;
+                }
+                while (v >= 100)
+                {
+                    p -= 2;
+                    std::memcpy(p, DIGIT_PAIRS + 2 * (v % 100), 2);
+                    v /= 100;
+                }
+                if (v >= 10)
+                {
+                    p -= 2;
+                    std::memcpy(p, DIGIT_PAIRS + 2 * v, 2);
+                }
+                else
+                {
+                    *--p = static_cast<char>('0' + v);
+                }
+                if (neg)
+                    *--p = '-';
+                size_t n = end - p;
+                std::memcpy(reserve(n), p, n);
+                m_len += n;
+            }
+
+            /// @brief Appends std::to_chars(args...), starting from a reserve of `guess` bytes and doubling it until it fits.
+            template <typename... Args>
+            void write_chars(size_t guess, const Args &...args)
+            {
+                for (size_t n = guess;; n *= 2)
+                {
+                    char *p = reserve(n);
+                    auto [end, ec] = std::to_chars(p, p + n, args...);
+                    if (ec == std::errc())
+                    {
+                        m_len = end - m_buf.data();
+                        return;
+                    }
+                }
+            }
+
+        public:
+            explicit FastWriter(FILE *file = stdout, size_t capacity = 1 << 16)
+                : m_file(file), m_buf(std::max<size_t>(capacity, 64)) {}
+
+            FastWriter(const FastWriter &) = delete;
+            FastWriter &operator=(const FastWriter &) = delete;
+
+            ~FastWriter() { flush(); }
+
+            void flush()
+            {
+                if (m_len > 0)
+                {
+                    std::fwrite(m_buf.data(), 1, m_len, m_file);
+                    m_len = 0;
+                }
+                std::fflush(m_file);
+            }
+
+            /// @brief Writes one value: an integer, char, string or floating-point number (shortest form).
+            template <typename T>
+            void write(const T &x)
+            {
+                if constexpr (std::is_same_v<T, char>)
+                {
+                    *reserve(1) = x;
+                    ++m_len;
+                }
+                else if constexpr (std::is_same_v<T, bool>)
+                {
+                    write(x ? '1' : '0');
+                }
+                else if constexpr (std::is_integral_v<T>)
+                {
+                    write_integer(x);
+                }
+                else if constexpr (std::is_floating_point_v<T>)
+                {
+                    write_chars(32, x);
+                }
+                else
+                {
+                    static_assert(std::is_convertible_v<const T &, std::string_view>, "FastWriter cannot write this type.");
+                    std::string_view s = x;
+                    std::memcpy(reserve(s.size()), s.data(), s.size());
+                    m_len += s.size();
+                }
+            }
+
+            /// @brief Writes x with `digits` digits after the decimal point.
+            void write_fixed(double x, int digits)
+            {
+                // Up to 309 integer digits, a sign, the point and the fraction.
+                write_chars(312 + static_cast<size_t>(std::max(digits, 0)), x, std::chars_format::fixed, digits);
+            }
+
+            template <int MOD>
+            void write(const Zn<MOD> &z) { write(z.value); }
+
+            /// @brief Writes the elements separated by single spaces.
+            template <typename T, typename A>
+            void write(const std::vector<T, A> &v)
+            {
+                for (size_t i = 0; i < v.size(); ++i)
+                {
+                    if (i > 0)
+                        write(' ');
+                    write(v[i]);
+                }
+            }
+
+            /// @brief Writes the array row by row: spaces along the last axis, a newline after each row.
+            template <typename T, typename A>
+            void write(const ::NDArray<T, A> &a)
+            {
+                if (a.ndim() == 0)
+                    return;
+                size_t row = a.shape().back(), col = 0;
+                a.view().for_each([this, row, &col](const T &x)
+                                  {
+                    if (col > 0)
+                        write(' ');
+                    write(x);
+                    if (++col == row)
+                    {
+                        write('\n');
+                        col = 0;
+                    } });
+            }
+
+            template <typename T, typename U, typename... Rest>
+            void write(const T &x, const U &y, const Rest &...rest)
+            {
+                write(x);
+                write(y);
+                (write(rest), ...);
+            }
+
+            /// @brief Writes the values separated by spaces, then a newline.
+            template <typename... Ts>
+            void writeln(const Ts &...xs)
+            {
+                bool first = true;
+                ((first ? void(first = false) : write(' '), write(xs)), ...);
+                write('\n');
+            }
+
+            template <typename T>
+            FastWriter &operator<<(const T &x)
+            {
+                write(x);
+                return *this;
+            }
+        };
+    }
+}
+
+/*
+int main()
+{
+    cp::io::FastReader in;
+    cp::io::FastWriter out;
+
+    int n;
+    in >> n;
+    std::vector<long long> a(n);
+    in >> a;
+
+    long long sum = 0;
+    for (long long x : a)
+        sum += x;
+    out.writeln(n, sum);  // "5 15" for input "5  1 2 3 4 5"
+    out << a << '\n';     // "1 2 3 4 5"
+
+    NDArray<cp::Zn<998244353>> grid({2, 3}); // needs ndarray.h and zn.h
+    in >> grid;                                // six integers, row-major
+    out << grid;                               // two lines of three
+    return 0;
+}
+*/
@@ -0,0 +1,90 @@
+#pragma once
+/*
+ * Over-aligned allocator for SIMD-friendly containers
+ * Operation: O(1) allocate(n), deallocate(p, n)
+ */
+
+// Allocations start on an Align-byte boundary (a cache line by default), so
+// aligned vector loads never straddle lines and two containers never share
+// the line holding their first element.
+//
+// construct(p) with no arguments default-initializes instead of
+// value-initializing. For trivial T, std::vector<T, AlignedAllocator<T>>::resize(n)
+// therefore leaves the new elements unwritten, like new T[n]. Use assign(n, T())
+// when zeros are needed.
+
+#include <cstddef>
+#include <new>
+#include <limits>
+#include <utility>
+#include <type_traits>
+
+#include "../debug/stats.h"
+
+namespace cp
+{
+    /**
+     * @brief A stateless allocator returning Align-byte aligned memory.
+     * @tparam T The element type.
+     * @tparam Align The alignment in bytes, a power of two (64 = one cache line).
+     */
+    template <typename T, size_t Align = 64>
+    struct AlignedAllocator
+    {
+        static_assert((Align & (Align - 1)) == 0, "Alignment must be a power of two.");
+
+        using value_type = T;
+        static constexpr size_t alignment = Align < alignof(T) ? alignof(T) : Align;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = AlignedAllocator<U, Align>;
+        };
+
+        AlignedAllocator() noexcept = default;
+
+        template <typename U>
+        AlignedAllocator(const AlignedAllocator<U, Align> &) noexcept {}
+
+        T *allocate(size_t n)
+        {
+            if (n > std::numeric_limits<size_t>::max() / sizeof(T))
+            {
+                throw std::bad_array_new_length();
+            }
+            CP_STAT("AlignedAllocator bytes", n * sizeof(T));
+            return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(alignment)));
+        }
+
+        void deallocate(T *p, size_t n) noexcept
+        {
+            ::operator delete(p, n * sizeof(T), std::align_val_t(alignment));
+        }
+
+        /// @brief Default-initializes (no zeroing for trivial types).
+        template <typename U>
+        void construct(U *p) noexcept(std::is_nothrow_default_constructible_v<U>)
+        {
+            ::new (static_cast<void *>(p)) U;
+        }
+
+        template <typename U, typename... Args>
+        void construct(U *p, Args &&...args)
+        {
+            ::new (static_cast<void *>(p)) U(std::forward<Args>(args)...);
+        }
+
+        template <typename U>
+        bool operator==(const AlignedAllocator<U, Align> &) const noexcept { return true; }
+    };
+}
+
+/*
+int main()
+{
+    std::vector<double, cp::AlignedAllocator<double>> v(1000);
+    printf("%d\n", (int)(reinterpret_cast<uintptr_t>(v.data()) % 64)); // 0
+    return 0;
+}
+*/
@@ -0,0 +1,231 @@
+#pragma once
+/*
+ * Monotonic arena and a stateless allocator drawing from it
+ * Operation: O(1) amortized allocate(bytes, align)
+ * Operation: O(1) reset()   every allocation is discarded, the memory is kept
+ * Operation: O(blocks) release()
+ */
+
+// An Arena hands out memory by bumping a pointer through a list of blocks and
+// never frees individual allocations. reset() rewinds to the first block, so
+// the next test case reuses the same blocks without touching malloc. Blocks
+// grow geometrically, so a test case that needs M bytes costs O(log M) mallocs
+// the first time and none afterwards.
+//
+// ArenaAllocator<T, Tag> is stateless: it draws from a thread-local Arena,
+// one per Tag, so it can be default constructed, rebound and copied as pb_ds
+// (OrderStatisticsTree, HashTable) and the standard containers require.
+// deallocate() is a no-op, so memory freed by a container (e.g. the old table
+// after a rehash) is only recovered by reset().
+//
+// Destroy every container using an arena before calling reset(): their
+// destructors still walk the nodes that reset() allows to be overwritten.
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+#include "../debug/stats.h"
+
+namespace cp
+{
+    /**
+     * @brief A monotonic (bump-pointer) memory resource with O(1) reset.
+     */
+    class Arena
+    {
+    private:
+        struct Block
+        {
+            std::byte *data;
+            size_t size;
+        };
+
+        std::vector<Block> m_blocks;
+        size_t m_current = 0; // index of the block being bumped
+        size_t m_offset = 0;  // bytes used in that block
+        size_t m_first_block;
+
+        static constexpr size_t BLOCK_ALIGN = 64;
+
+        /// @brief Moves to the first later block of at least `need` bytes, allocating one if there is none.
+        void next_block(size_t need)
+        {
+            size_t next = m_blocks.empty() ? 0 : m_current + 1;
+            while (next < m_blocks.size() && m_blocks[next].size < need)
+                ++next;
+            if (next == m_blocks.size())
+            {
+                size_t size = std::max(m_blocks.empty() ? m_first_block : 2 * m_blocks.back().size, need);
+                auto *data = static_cast<std::byte *>(::operator new(size, std::align_val_t(BLOCK_ALIGN)));
+                m_blocks.push_back({data, size});
+            }
+            m_current = next;
+            m_offset = 0;
+        }
+
+        /// @brief The offset of the first `align`-aligned address at or after m_offset in the current block.
+        size_t aligned_offset(size_t align) const
+        {
+            auto base = reinterpret_cast<std::uintptr_t>(m_blocks[m_current].data);
+            return ((base + m_offset + align - 1) & ~(align - 1)) - base;
+        }
+
+    public:
+        /**
+         * @brief Constructs an empty arena; nothing is allocated until first use.
+         * @param first_block The size in bytes of the first block. Later blocks double.
+         */
+        explicit Arena(size_t first_block = 1 << 16) : m_first_block(std::max<size_t>(first_block, BLOCK_ALIGN)) {}
+
+        Arena(const Arena &) = delete;
+        Arena &operator=(const Arena &) = delete;
+
+        ~Arena() { release(); }
+
+        /**
+         * @brief Returns `bytes` bytes aligned to `align` (a power of two).
+         * @complexity O(1) amortized.
+         */
+        void *allocate(size_t bytes, size_t align = alignof(std::max_align_t))
+        {
+            CP_STAT("Arena bytes", bytes);
+            size_t start = m_blocks.empty() ? 0 : aligned_offset(align);
+            if (m_blocks.empty() || start + bytes > m_blocks[m_current].size)
+            {
+                next_block(bytes + (align > BLOCK_ALIGN ? align : 0));
+                start = aligned_offset(align);
+            }
+            m_offset = start + bytes;
+            return m_blocks[m_current].data + start;
+        }
+
+        /**
+         * @brief Discards every allocation but keeps the blocks for reuse.
+         * @complexity O(1)
+         */
+        void reset()
+        {
+            m_current = 0;
+            m_offset = 0;
+        }
+
+        /// @brief Returns every block to the system.
+        void release()
+        {
+            for (const Block &b : m_blocks)
+                ::operator delete(b.data, b.size, std::align_val_t(BLOCK_ALIGN));
+            m_blocks.clear();
+            reset();
+        }
+
+        /// @brief Total bytes held in blocks.
+        size_t capacity() const
+        {
+            size_t total = 0;
+            for (const Block &b : m_blocks)
+                total += b.size;
+            return total;
+        }
+
+        /// @brief Bytes consumed since the last reset(), including alignment gaps and block tails.
+        size_t used() const
+        {
+            if (m_blocks.empty())
+                return 0;
+            size_t total = m_offset;
+            for (size_t i = 0; i < m_current; ++i)
+                total += m_blocks[i].size;
+            return total;
+        }
+
+        /**
+         * @brief The calling thread's arena for a given tag, created on first use.
+         * @tparam Tag Any type; different tags give independent arenas.
+         */
+        template <typename Tag = void>
+        static Arena &local()
+        {
+            thread_local Arena arena;
+            return arena;
+        }
+    };
+
+    /**
+     * @brief A stateless allocator backed by Arena::local<Tag>() of the calling thread.
+     * @tparam T The value type.
+     * @tparam Tag Selects the arena; containers sharing a tag share an arena.
+     *
+     * Memory must be released on the thread that allocated it: reset the arena
+     * there. Containers must not be moved to another thread.
+     */
+    template <typename T, typename Tag = void>
+    struct ArenaAllocator
+    {
+        using value_type = T;
+        // pb_ds still reads the pre-C++11 allocator members.
+        using size_type = size_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using reference = T &;
+        using const_reference = const T &;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = ArenaAllocator<U, Tag>;
+        };
+
+        ArenaAllocator() noexcept = default;
+
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U, Tag> &) noexcept {}
+
+        /// @brief The arena this allocator (and every rebound copy) draws from.
+        static Arena &arena() { return Arena::local<Tag>(); }
+
+        /// @brief Discards everything allocated through this tag on the calling thread.
+        static void reset() { arena().reset(); }
+
+        T *allocate(size_t n)
+        {
+            if (n > std::numeric_limits<size_t>::max() / sizeof(T))
+            {
+                throw std::bad_array_new_length();
+            }
+            return static_cast<T *>(arena().allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T *, size_t) noexcept {}
+
+        template <typename U>
+        bool operator==(const ArenaAllocator<U, Tag> &) const noexcept { return true; }
+        template <typename U>
+        bool operator!=(const ArenaAllocator<U, Tag> &) const noexcept { return false; }
+    };
+}
+
+/*
+int main()
+{
+    struct Case; // tag: an arena just for the per-test containers
+    using Alloc = cp::ArenaAllocator<char, Case>;
+
+    int tests = 1000;
+    while (tests--)
+    {
+        {
+            OrderStatisticsTree<int, __gnu_pbds::null_type, std::less<int>, Alloc> tree; // order_statistics_tree.h
+            HashTable<int, int, Alloc> freq;                                              // hash_table.h
+            for (int i = 0; i < 1000; ++i)
+                tree.insert(i), freq[i % 7]++;
+        }
+        Alloc::reset(); // O(1); the next case reuses the same blocks
+    }
+    return 0;
+}
+*/
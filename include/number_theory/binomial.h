@@ -0,0 +1,178 @@
+#pragma once
+/*
+ * Binomial coefficients modulo a prime
+ * Operation: O(N) build of factorial and inverse-factorial tables (one inverse() call)
+ * Operation: O(1) fact(n), inv_fact(n), inv(n), nCr(n, r), nPr(n, r)
+ */
+
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+#include "zn.h"
+
+namespace cp
+{
+    /**
+     * @brief Factorial and inverse-factorial tables with O(1) nCr queries.
+     *
+     * Tables are built with a forward sweep for n!, a single `inverse()` of N!,
+     * and a backward sweep inv_fact[i - 1] = inv_fact[i] * i. With a fixed `N`
+     * the tables live in `std::array` and the constructor is `constexpr`, so a
+     * `constexpr Binomial<MOD, N>` is computed entirely at compile time (keep N
+     * small enough for the compiler's constexpr limits, e.g. a few thousand).
+     * Use `Binomial<MOD>` (N = 0) for large or unknown bounds: it grows lazily.
+     *
+     * @tparam MOD A prime modulus.
+     * @tparam N The largest supported n, or 0 for a lazily growing table.
+     */
+    template <int MOD, size_t N = 0>
+    class Binomial
+    {
+        static_assert(N < static_cast<size_t>(MOD), "Factorials up to N must be invertible modulo MOD.");
+
+    private:
+        std::array<Zn<MOD>, N + 1> m_fact{}, m_inv_fact{};
+
+    public:
+        /**
+         * @brief Builds the tables for every n in [0, N].
+         * @complexity O(N + log MOD)
+         */
+        constexpr Binomial()
+        {
+            m_fact[0] = 1;
+            for (size_t i = 1; i <= N; ++i)
+                m_fact[i] = m_fact[i - 1] * Zn<MOD>(static_cast<long long>(i));
+            m_inv_fact[N] = m_fact[N].inverse();
+            for (size_t i = N; i > 0; --i)
+                m_inv_fact[i - 1] = m_inv_fact[i] * Zn<MOD>(static_cast<long long>(i));
+        }
+
+        /// @brief Returns n! for 0 <= n <= N.
+        constexpr Zn<MOD> fact(size_t n) const { return m_fact[n]; }
+
+        /// @brief Returns (n!)^{-1} for 0 <= n <= N.
+        constexpr Zn<MOD> inv_fact(size_t n) const { return m_inv_fact[n]; }
+
+        /// @brief Returns n^{-1} for 1 <= n <= N, without calling `power()`.
+        constexpr Zn<MOD> inv(size_t n) const { return m_inv_fact[n] * m_fact[n - 1]; }
+
+        /// @brief Returns C(n, r), or 0 if r < 0 or r > n. Requires n <= N.
+        constexpr Zn<MOD> nCr(long long n, long long r) const
+        {
+            if (r < 0 || r > n)
+                return 0;
+            return m_fact[n] * m_inv_fact[r] * m_inv_fact[n - r];
+        }
+
+        /// @brief Returns n! / (n - r)!, or 0 if r < 0 or r > n. Requires n <= N.
+        constexpr Zn<MOD> nPr(long long n, long long r) const
+        {
+            if (r < 0 || r > n)
+                return 0;
+            return m_fact[n] * m_inv_fact[n - r];
+        }
+    };
+
+    /**
+     * @brief Lazily growing factorial tables with amortized O(1) nCr queries.
+     *
+     * Queries beyond the current size grow the tables to at least twice their
+     * size. Each growth step extends the forward sweep, calls `inverse()` once
+     * on the new largest factorial, and sweeps backwards over the new range.
+     *
+     * @tparam MOD A prime modulus.
+     */
+    template <int MOD>
+    class Binomial<MOD, 0>
+    {
+    private:
+        std::vector<Zn<MOD>> m_fact{1}, m_inv_fact{1};
+
+        void ensure(size_t n)
+        {
+            size_t old_size = m_fact.size();
+            if (n < old_size)
+                return;
+
+            size_t new_size = std::max(n + 1, 2 * old_size);
+            m_fact.resize(new_size);
+            m_inv_fact.resize(new_size);
+            for (size_t i = old_size; i < new_size; ++i)
+                m_fact[i] = m_fact[i - 1] * Zn<MOD>(static_cast<long long>(i));
+            m_inv_fact[new_size - 1] = m_fact[new_size - 1].inverse();
+            for (size_t i = new_size - 1; i > old_size; --i)
+                m_inv_fact[i - 1] = m_inv_fact[i] * Zn<MOD>(static_cast<long long>(i));
+        }
+
+    public:
+        /**
+         * @brief Constructs the tables, optionally pre-sized for n <= max_n.
+         * @param max_n The expected largest n; the tables still grow on demand.
+         * @complexity O(max_n + log MOD)
+         */
+        explicit Binomial(size_t max_n = 0)
+        {
+            ensure(max_n);
+        }
+
+        /// @brief Returns n!.
+        Zn<MOD> fact(size_t n)
+        {
+            ensure(n);
+            return m_fact[n];
+        }
+
+        /// @brief Returns (n!)^{-1}.
+        Zn<MOD> inv_fact(size_t n)
+        {
+            ensure(n);
+            return m_inv_fact[n];
+        }
+
+        /// @brief Returns n^{-1} for n >= 1, without calling `power()`.
+        Zn<MOD> inv(size_t n)
+        {
+            ensure(n);
+            return m_inv_fact[n] * m_fact[n - 1];
+        }
+
+        /// @brief Returns C(n, r), or 0 if r < 0 or r > n.
+        Zn<MOD> nCr(long long n, long long r)
+        {
+            if (r < 0 || r > n)
+                return 0;
+            ensure(n);
+            return m_fact[n] * m_inv_fact[r] * m_inv_fact[n - r];
+        }
+
+        /// @brief Returns n! / (n - r)!, or 0 if r < 0 or r > n.
+        Zn<MOD> nPr(long long n, long long r)
+        {
+            if (r < 0 || r > n)
+                return 0;
+            ensure(n);
+            return m_fact[n] * m_inv_fact[n - r];
+        }
+    };
+}
+
+/*
+int main()
+{
+    constexpr int MOD = 1000000007;
+
+    // Compile-time tables: no startup cost, no code run at program start
+    static constexpr cp::Binomial<MOD, 1000> small;
+    static_assert(small.nCr(10, 3) == cp::Zn<MOD>(120));
+    std::cout << "C(1000, 500) = " << small.nCr(1000, 500) << std::endl;
+
+    // Lazily growing tables
+    cp::Binomial<MOD> binom;
+    std::cout << "C(10^6, 3) = " << binom.nCr(1000000, 3) << std::endl;
+    std::cout << "P(5, 2) = " << binom.nPr(5, 2) << std::endl;  // 20
+    std::cout << "inv(2) = " << binom.inv(2) << std::endl;      // 500000004
+}
+*/
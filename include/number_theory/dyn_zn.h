@@ -0,0 +1,203 @@
+#pragma once
+
+#include <iostream>
+#include <cassert>
+#include <utility>
+
+namespace cp
+{
+    /**
+     * @brief Barrett reduction context for a runtime modulus.
+     *
+     * Stores the modulus `m` together with the precomputed constant
+     * `im = ceil(2^64 / m)`, so that products can be reduced with two
+     * multiplications and one conditional correction instead of a divide.
+     */
+    struct Barrett
+    {
+        unsigned int m;
+        unsigned long long im;
+
+        /// @param m The modulus. Must satisfy 1 <= m < 2^31.
+        explicit Barrett(unsigned int m) : m(m), im(~0ULL / m + 1) {}
+
+        /**
+         * @brief Computes (a * b) % m.
+         * @param a A value in [0, m).
+         * @param b A value in [0, m).
+         */
+        unsigned int mul(unsigned int a, unsigned int b) const
+        {
+            unsigned long long z = static_cast<unsigned long long>(a) * b;
+            unsigned long long x = static_cast<unsigned long long>((static_cast<__uint128_t>(z) * im) >> 64);
+            unsigned long long y = x * m;
+            return static_cast<unsigned int>(z - y + (z < y ? m : 0));
+        }
+    };
+
+    /**
+     * @brief Represents an integer in the ring Z/nZ where n is chosen at runtime.
+     *
+     * A companion to `Zn` for moduli that are only known after reading the input.
+     * The modulus lives in a per-`Id` `Barrett` context that is set once with
+     * `set_mod()`; multiplication then uses Barrett reduction and never issues a
+     * hardware divide. Use distinct `Id` values to work with several runtime
+     * moduli at the same time.
+     *
+     * @tparam Id A tag distinguishing independent moduli.
+     */
+    template <int Id = -1>
+    struct DynZn
+    {
+    private:
+        static Barrett &context()
+        {
+            static Barrett ctx(998244353);
+            return ctx;
+        }
+
+    public:
+        int value;
+
+        /**
+         * @brief Sets the modulus shared by every `DynZn<Id>`.
+         * @param m The modulus. Must satisfy 1 <= m < 2^31.
+         * @note Existing values are not re-reduced; set the modulus before use.
+         */
+        static void set_mod(int m)
+        {
+            assert(m >= 1);
+            context() = Barrett(static_cast<unsigned int>(m));
+        }
+
+        /// @brief Returns the current modulus.
+        static int mod() { return static_cast<int>(context().m); }
+
+        /// @brief Default constructor, initializes value to 0.
+        DynZn(long long v = 0)
+        {
+            value = static_cast<int>(v % mod());
+            if (value < 0)
+                value += mod();
+        }
+
+        /**
+         * @brief Calculates the modular multiplicative inverse.
+         *
+         * Uses the extended Euclidean algorithm, so the modulus does not have to
+         * be prime.
+         * @note This requires gcd(value, mod()) == 1.
+         * @return The modular inverse as a `DynZn` object.
+         */
+        DynZn inverse() const
+        {
+            long long a = value, b = mod(), x = 1, y = 0;
+            while (b != 0)
+            {
+                long long q = a / b;
+                a -= q * b;
+                std::swap(a, b);
+                x -= q * y;
+                std::swap(x, y);
+            }
+            assert(a == 1);
+            return DynZn(x);
+        }
+
+        /**
+         * @brief Calculates modular exponentiation (this^exp).
+         * @param exp The exponent.
+         * @return The result of (this->value ^ exp) % mod().
+         */
+        DynZn power(long long exp) const
+        {
+            DynZn res = 1, base = *this;
+            while (exp > 0)
+            {
+                if (exp % 2 == 1)
+                    res *= base;
+                base *= base;
+                exp /= 2;
+            }
+            return res;
+        }
+
+        /// @brief Adds another DynZn value to this one.
+        DynZn &operator+=(const DynZn &other)
+        {
+            // In unsigned: for moduli from 2^30 the sum of two residues exceeds INT_MAX.
+            unsigned int s = static_cast<unsigned int>(value) + static_cast<unsigned int>(other.value);
+            if (s >= context().m)
+                s -= context().m;
+            value = static_cast<int>(s);
+            return *this;
+        }
+
+        /// @brief Subtracts another DynZn value from this one.
+        DynZn &operator-=(const DynZn &other)
+        {
+            value -= other.value;
+            if (value < 0)
+                value += mod();
+            return *this;
+        }
+
+        /// @brief Multiplies this DynZn value by another one.
+        DynZn &operator*=(const DynZn &other)
+        {
+            value = static_cast<int>(context().mul(value, other.value));
+            return *this;
+        }
+
+        /// @brief Divides this DynZn value by another one.
+        DynZn &operator/=(const DynZn &other)
+        {
+            return *this *= other.inverse();
+        }
+
+        /// @brief Unary negation operator.
+        DynZn operator-() const { return DynZn(-value); }
+
+        // Friend functions for binary and stream operators
+        friend DynZn operator+(DynZn a, const DynZn &b) { return a += b; }
+        friend DynZn operator-(DynZn a, const DynZn &b) { return a -= b; }
+        friend DynZn operator*(DynZn a, const DynZn &b) { return a *= b; }
+        friend DynZn operator/(DynZn a, const DynZn &b) { return a /= b; }
+
+        friend bool operator==(const DynZn &a, const DynZn &b) { return a.value == b.value; }
+        friend bool operator!=(const DynZn &a, const DynZn &b) { return a.value != b.value; }
+
+        friend std::ostream &operator<<(std::ostream &os, const DynZn &z) { return os << z.value; }
+        friend std::istream &operator>>(std::istream &is, DynZn &z)
+        {
+            long long v;
+            is >> v;
+            z = DynZn(v);
+            return is;
+        }
+
+        /// @brief Explicit conversion to the underlying integer type.
+        explicit operator int() const { return value; }
+    };
+}
+
+/*
+int main()
+{
+    int m;
+    std::cin >> m; // e.g. 1000000 (not prime)
+    cp::DynZn<>::set_mod(m);
+
+    using mint = cp::DynZn<>;
+
+    mint a = 123456, b = 7;
+    std::cout << "a * b = " << a * b << std::endl;        // 864192
+    std::cout << "b^-1 = " << b.inverse() << std::endl;    // 857143, since 7 * 857143 = 6000001
+    std::cout << "a / b * b = " << a / b * b << std::endl; // 123456
+    std::cout << "b^20 = " << b.power(20) << std::endl;
+
+    cp::DynZn<1>::set_mod(2147483647); // the largest modulus: 2^31 - 1
+    cp::DynZn<1> big = 2147483646;
+    std::cout << big + big << " " << big * big << " " << -big + big << std::endl; // 2147483645 1 0
+}
+*/
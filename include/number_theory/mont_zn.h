@@ -0,0 +1,198 @@
+#pragma once
+
+#include <iostream>
+#include <cstdint>
+#include <type_traits>
+#include <bit>
+
+#include "../debug/stats.h"
+
+namespace cp
+{
+    /**
+     * @brief Represents an integer in Z/nZ, stored in Montgomery form.
+     *
+     * A drop-in alternative to `Zn` for multiplication-heavy code. Every value `x`
+     * is kept as `x * R mod MOD` (with `R = 2^32` or `R = 2^64`), which lets
+     * multiplication use Montgomery reduction (REDC) instead of a hardware divide.
+     * Conversion to and from the normal representation only happens at
+     * construction, I/O, and the explicit integer conversions.
+     *
+     * Moduli below 2^31 use 32-bit storage with 64-bit products; moduli up to
+     * 2^63 use 64-bit storage with `__uint128_t` products.
+     *
+     * @tparam MOD The modulus. Must be odd and in the range (1, 2^63).
+     */
+    template <unsigned long long MOD>
+    struct MontZn
+    {
+        static_assert(MOD > 1 && MOD % 2 == 1, "Montgomery form requires an odd modulus greater than 1.");
+        static_assert(MOD < (1ULL << 63), "Modulus must be less than 2^63.");
+
+        /// @brief Storage type: 32-bit for MOD < 2^31, otherwise 64-bit.
+        using uint = std::conditional_t<(MOD < (1ULL << 31)), std::uint32_t, std::uint64_t>;
+        /// @brief Double-width type used for intermediate products.
+        using ulong = std::conditional_t<(MOD < (1ULL << 31)), std::uint64_t, __uint128_t>;
+
+    private:
+        static constexpr int BITS = 8 * sizeof(uint);
+
+        /// @brief Computes -MOD^{-1} mod R using Newton's iteration.
+        static constexpr uint neg_inverse()
+        {
+            uint inv = static_cast<uint>(MOD); // correct to 3 bits for odd MOD
+            for (int i = 0; i < 5; ++i)
+            {
+                inv *= static_cast<uint>(2) - static_cast<uint>(MOD) * inv;
+            }
+            return static_cast<uint>(0) - inv;
+        }
+
+        static constexpr uint N_PRIME = neg_inverse();
+        static constexpr uint R1 = static_cast<uint>((static_cast<ulong>(1) << BITS) % MOD);
+        static constexpr uint R2 = static_cast<uint>(static_cast<ulong>(R1) * R1 % MOD);
+
+        /**
+         * @brief Montgomery reduction: returns t * R^{-1} mod MOD.
+         * @param t A double-width value less than MOD * R.
+         */
+        static constexpr uint reduce(ulong t)
+        {
+            uint m = static_cast<uint>(t) * N_PRIME;
+            uint r = static_cast<uint>((t + static_cast<ulong>(m) * MOD) >> BITS);
+            return r >= MOD ? r - static_cast<uint>(MOD) : r;
+        }
+
+    public:
+        /// @brief The Montgomery representation, `value * R mod MOD`.
+        uint raw;
+
+        /// @brief Default constructor, initializes value to 0.
+        constexpr MontZn(long long v = 0) : raw(0)
+        {
+            long long x = v % static_cast<long long>(MOD);
+            if (x < 0)
+                x += MOD;
+            raw = reduce(static_cast<ulong>(x) * R2);
+        }
+
+        /// @brief Builds a MontZn directly from a Montgomery representation.
+        static constexpr MontZn from_raw(uint r)
+        {
+            MontZn z;
+            z.raw = r;
+            return z;
+        }
+
+        /// @brief Returns the value in normal (non-Montgomery) representation.
+        constexpr uint val() const { return reduce(raw); }
+
+        /**
+         * @brief Calculates the modular multiplicative inverse.
+         *
+         * Uses Fermat's Little Theorem for the calculation.
+         * @note This requires the modulus `MOD` to be a prime number.
+         * @return The modular inverse as a `MontZn` object.
+         */
+        constexpr MontZn inverse() const
+        {
+            return power(MOD - 2);
+        }
+
+        /**
+         * @brief Calculates modular exponentiation (this^exp).
+         * @param exp The exponent.
+         * @return The result of (this->val() ^ exp) % MOD.
+         */
+        constexpr MontZn power(unsigned long long exp) const
+        {
+            CP_STAT("MontZn::power", std::bit_width(exp));
+            MontZn res = from_raw(R1), base = *this;
+            while (exp > 0)
+            {
+                if (exp & 1)
+                    res *= base;
+                base *= base;
+                exp >>= 1;
+            }
+            return res;
+        }
+
+        /// @brief Adds another MontZn value to this one.
+        constexpr MontZn &operator+=(const MontZn &other)
+        {
+            raw += other.raw;
+            if (raw >= MOD)
+                raw -= static_cast<uint>(MOD);
+            return *this;
+        }
+
+        /// @brief Subtracts another MontZn value from this one.
+        constexpr MontZn &operator-=(const MontZn &other)
+        {
+            raw = raw >= other.raw ? raw - other.raw : raw + static_cast<uint>(MOD) - other.raw;
+            return *this;
+        }
+
+        /// @brief Multiplies this MontZn value by another one.
+        constexpr MontZn &operator*=(const MontZn &other)
+        {
+            raw = reduce(static_cast<ulong>(raw) * other.raw);
+            return *this;
+        }
+
+        /// @brief Divides this MontZn value by another one.
+        constexpr MontZn &operator/=(const MontZn &other)
+        {
+            return *this *= other.inverse();
+        }
+
+        /// @brief Unary negation operator.
+        constexpr MontZn operator-() const { return from_raw(raw == 0 ? 0 : static_cast<uint>(MOD) - raw); }
+
+        // Friend functions for binary and stream operators
+        friend constexpr MontZn operator+(MontZn a, const MontZn &b) { return a += b; }
+        friend constexpr MontZn operator-(MontZn a, const MontZn &b) { return a -= b; }
+        friend constexpr MontZn operator*(MontZn a, const MontZn &b) { return a *= b; }
+        friend constexpr MontZn operator/(MontZn a, const MontZn &b) { return a /= b; }
+
+        friend constexpr bool operator==(const MontZn &a, const MontZn &b) { return a.raw == b.raw; }
+        friend constexpr bool operator!=(const MontZn &a, const MontZn &b) { return a.raw != b.raw; }
+
+        friend std::ostream &operator<<(std::ostream &os, const MontZn &z) { return os << z.val(); }
+        friend std::istream &operator>>(std::istream &is, MontZn &z)
+        {
+            long long v;
+            is >> v;
+            z = MontZn(v);
+            return is;
+        }
+
+        /// @brief Explicit conversion to `int` (only meaningful for MOD < 2^31).
+        explicit constexpr operator int() const { return static_cast<int>(val()); }
+
+        /// @brief Explicit conversion to `long long`, valid for every supported MOD.
+        explicit constexpr operator long long() const { return static_cast<long long>(val()); }
+    };
+}
+
+/*
+int main()
+{
+    // 32-bit modulus: values stored in a uint32_t, products in a uint64_t
+    using mint = cp::MontZn<998244353>;
+
+    mint a = 3, b = -1;
+    std::cout << "a * b = " << a * b << std::endl;         // 998244350
+    std::cout << "a^-1 * a = " << a.inverse() * a << std::endl; // 1
+    std::cout << "3^(p-1) = " << a.power(998244352) << std::endl; // 1
+
+    // 64-bit modulus: values stored in a uint64_t, products in a __uint128_t
+    using mint64 = cp::MontZn<(1ULL << 61) - 1>;
+
+    mint64 c = 1LL << 40, d = 1LL << 30;
+    std::cout << "c * d = " << c * d << std::endl;         // 2^70 mod (2^61 - 1) = 512
+    std::cout << "c / d = " << c / d << std::endl;         // 2^10 = 1024
+    std::cout << "(long long)c = " << static_cast<long long>(c) << std::endl;
+}
+*/
@@ -0,0 +1,298 @@
+#pragma once
+/*
+ * Number-Theoretic Transform
+ * Operation: O(n log n) ntt(a), inverse ntt(a)
+ * Operation: O((n + m) log(n + m)) convolve(a, b) modulo an NTT-friendly prime
+ * Operation: O((n + m) log(n + m)) convolve_arbitrary(a, b) modulo any MOD < 2^31
+ */
+
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include <type_traits>
+#include <utility>
+
+#include "zn.h"
+
+namespace cp
+{
+    namespace ntt_detail
+    {
+        /// @brief Computes (b ^ e) % m with 64-bit intermediates.
+        constexpr unsigned long long pow_mod(unsigned long long b, unsigned long long e, unsigned long long m)
+        {
+            unsigned long long res = 1 % m;
+            b %= m;
+            while (e > 0)
+            {
+                if (e & 1)
+                    res = res * b % m;
+                b = b * b % m;
+                e >>= 1;
+            }
+            return res;
+        }
+
+        /// @brief Finds the smallest primitive root of a prime `mod`.
+        constexpr int primitive_root(int mod)
+        {
+            int factors[32] = {};
+            int count = 0;
+            int x = mod - 1;
+            for (int p = 2; 1LL * p * p <= x; ++p)
+            {
+                if (x % p == 0)
+                {
+                    factors[count++] = p;
+                    while (x % p == 0)
+                        x /= p;
+                }
+            }
+            if (x > 1)
+                factors[count++] = x;
+
+            for (int g = 2;; ++g)
+            {
+                bool ok = true;
+                for (int i = 0; i < count && ok; ++i)
+                    ok = pow_mod(g, (mod - 1) / factors[i], mod) != 1;
+                if (ok)
+                    return g;
+            }
+        }
+
+        /// @brief Returns the largest `k` such that 2^k divides `mod - 1`.
+        constexpr int two_adicity(int mod)
+        {
+            int k = 0;
+            while (((mod - 1) >> k & 1) == 0)
+                ++k;
+            return k;
+        }
+
+        /**
+         * @brief Per-modulus cache of twiddle factors.
+         *
+         * Level `len` (a power of two) occupies indices [len, 2 * len) and holds
+         * w^j for j < len, where w is a primitive (2 * len)-th root of unity. Each
+         * root is stored together with its Shoup constant floor(w * 2^32 / MOD),
+         * which turns a multiplication by a fixed root into a few 32/64-bit
+         * multiplies and no division. The table only grows, so every level is
+         * computed exactly once per program run.
+         */
+        template <int MOD>
+        struct RootTable
+        {
+            std::vector<unsigned> w, ws, iw, iws;
+
+            static RootTable &get()
+            {
+                static RootTable table;
+                return table;
+            }
+
+            /// @brief Makes sure levels up to transform length `n` are present.
+            void ensure(size_t n)
+            {
+                if (w.size() >= n)
+                    return;
+                assert(n <= (size_t(1) << two_adicity(MOD)));
+
+                size_t len = std::max<size_t>(w.size(), 1);
+                w.resize(n), ws.resize(n), iw.resize(n), iws.resize(n);
+                constexpr int g = primitive_root(MOD);
+                for (; len < n; len <<= 1)
+                {
+                    unsigned long long root = pow_mod(g, (MOD - 1) / (2 * len), MOD);
+                    unsigned long long iroot = pow_mod(root, MOD - 2, MOD);
+                    unsigned long long cur = 1, icur = 1;
+                    for (size_t j = 0; j < len; ++j)
+                    {
+                        w[len + j] = static_cast<unsigned>(cur);
+                        ws[len + j] = static_cast<unsigned>((cur << 32) / MOD);
+                        iw[len + j] = static_cast<unsigned>(icur);
+                        iws[len + j] = static_cast<unsigned>((icur << 32) / MOD);
+                        cur = cur * root % MOD;
+                        icur = icur * iroot % MOD;
+                    }
+                }
+            }
+        };
+
+        /**
+         * @brief Iterative radix-2 transform on raw residues.
+         *
+         * The butterfly inner loop is branch-free and walks `a` and the root
+         * table with unit stride, so it auto-vectorizes under -O3.
+         */
+        template <int MOD>
+        void transform(unsigned *a, size_t n, const unsigned *w, const unsigned *ws)
+        {
+            for (size_t i = 1, j = 0; i < n; ++i)
+            {
+                size_t bit = n >> 1;
+                for (; j & bit; bit >>= 1)
+                    j ^= bit;
+                j ^= bit;
+                if (i < j)
+                    std::swap(a[i], a[j]);
+            }
+
+            constexpr unsigned mod = MOD;
+            for (size_t len = 1; len < n; len <<= 1)
+            {
+                const unsigned *wl = w + len, *wsl = ws + len;
+                for (size_t i = 0; i < n; i += 2 * len)
+                {
+                    unsigned *lo = a + i, *hi = a + i + len;
+                    for (size_t j = 0; j < len; ++j)
+                    {
+                        // Shoup multiplication: hi[j] * wl[j] mod MOD, in [0, 2 * MOD)
+                        unsigned q = static_cast<unsigned>((static_cast<unsigned long long>(hi[j]) * wsl[j]) >> 32);
+                        unsigned v = hi[j] * wl[j] - q * mod;
+                        v = v >= mod ? v - mod : v;
+
+                        unsigned u = lo[j];
+                        unsigned s = u + v, d = u - v + mod;
+                        lo[j] = s >= mod ? s - mod : s;
+                        hi[j] = d >= mod ? d - mod : d;
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief In-place number-theoretic transform.
+     * @tparam MOD An NTT-friendly prime (2^k divides MOD - 1 for large k).
+     * @param a The sequence to transform. Its size must be a power of two.
+     * @param invert If true, computes the inverse transform (including the 1/n factor).
+     * @complexity O(n log n)
+     */
+    template <int MOD>
+    void ntt(std::vector<Zn<MOD>> &a, bool invert = false)
+    {
+        static_assert(sizeof(Zn<MOD>) == sizeof(unsigned) && std::is_standard_layout_v<Zn<MOD>>,
+                      "Zn must be a thin wrapper around its value.");
+        size_t n = a.size();
+        assert((n & (n - 1)) == 0);
+        if (n <= 1)
+            return;
+
+        auto &table = ntt_detail::RootTable<MOD>::get();
+        table.ensure(n);
+
+        // Zn<MOD> is layout-compatible with its int value, which lies in [0, MOD).
+        unsigned *raw = reinterpret_cast<unsigned *>(a.data());
+        if (!invert)
+        {
+            ntt_detail::transform<MOD>(raw, n, table.w.data(), table.ws.data());
+            return;
+        }
+
+        ntt_detail::transform<MOD>(raw, n, table.iw.data(), table.iws.data());
+        Zn<MOD> scale = Zn<MOD>(static_cast<long long>(n)).inverse();
+        for (auto &x : a)
+            x *= scale;
+    }
+
+    /**
+     * @brief Computes the convolution c[k] = sum(a[i] * b[k - i]) modulo an NTT-friendly prime.
+     * @tparam MOD An NTT-friendly prime, e.g. 998244353.
+     * @return A vector of size a.size() + b.size() - 1 (empty if either input is empty).
+     * @complexity O((n + m) log(n + m)); falls back to O(n * m) for tiny inputs.
+     */
+    template <int MOD>
+    std::vector<Zn<MOD>> convolve(std::vector<Zn<MOD>> a, std::vector<Zn<MOD>> b)
+    {
+        if (a.empty() || b.empty())
+            return {};
+
+        size_t result_size = a.size() + b.size() - 1;
+        if (std::min(a.size(), b.size()) <= 32)
+        {
+            std::vector<Zn<MOD>> c(result_size);
+            for (size_t i = 0; i < a.size(); ++i)
+                for (size_t j = 0; j < b.size(); ++j)
+                    c[i + j] += a[i] * b[j];
+            return c;
+        }
+
+        size_t n = 1;
+        while (n < result_size)
+            n <<= 1;
+        a.resize(n), b.resize(n);
+        ntt(a), ntt(b);
+        for (size_t i = 0; i < n; ++i)
+            a[i] *= b[i];
+        ntt(a, true);
+        a.resize(result_size);
+        return a;
+    }
+
+    /**
+     * @brief Computes the convolution modulo an arbitrary MOD.
+     *
+     * Convolves modulo three NTT-friendly primes and recombines the results
+     * with Garner's algorithm (Chinese Remainder Theorem). The exact result is
+     * recovered as long as n * (MOD - 1)^2 < 998244353 * 167772161 * 469762049.
+     *
+     * @tparam MOD Any modulus below 2^31, prime or not.
+     * @complexity O((n + m) log(n + m)), about 3x the cost of `convolve`.
+     */
+    template <int MOD>
+    std::vector<Zn<MOD>> convolve_arbitrary(const std::vector<Zn<MOD>> &a, const std::vector<Zn<MOD>> &b)
+    {
+        constexpr int P1 = 998244353, P2 = 167772161, P3 = 469762049;
+        constexpr unsigned long long P1P2 = 1ULL * P1 * P2;
+        constexpr unsigned long long INV_P1_MOD_P2 = ntt_detail::pow_mod(P1, P2 - 2, P2);
+        constexpr unsigned long long INV_P1P2_MOD_P3 = ntt_detail::pow_mod(P1P2 % P3, P3 - 2, P3);
+
+        if (a.empty() || b.empty())
+            return {};
+
+        auto convolve_mod = [&](auto prime_tag)
+        {
+            constexpr int P = decltype(prime_tag)::value;
+            std::vector<Zn<P>> x(a.size()), y(b.size());
+            for (size_t i = 0; i < a.size(); ++i)
+                x[i] = Zn<P>(a[i].value);
+            for (size_t i = 0; i < b.size(); ++i)
+                y[i] = Zn<P>(b[i].value);
+            return convolve(std::move(x), std::move(y));
+        };
+
+        auto c1 = convolve_mod(std::integral_constant<int, P1>{});
+        auto c2 = convolve_mod(std::integral_constant<int, P2>{});
+        auto c3 = convolve_mod(std::integral_constant<int, P3>{});
+
+        std::vector<Zn<MOD>> c(c1.size());
+        const Zn<MOD> p1p2_mod = Zn<MOD>(static_cast<long long>(P1P2 % MOD));
+        for (size_t i = 0; i < c.size(); ++i)
+        {
+            unsigned long long r1 = c1[i].value, r2 = c2[i].value, r3 = c3[i].value;
+            unsigned long long t1 = (r2 + P2 - r1 % P2) % P2 * INV_P1_MOD_P2 % P2;
+            unsigned long long x12 = r1 + t1 * P1; // exact value modulo P1 * P2
+            unsigned long long t2 = (r3 + P3 - x12 % P3) % P3 * INV_P1P2_MOD_P3 % P3;
+            c[i] = Zn<MOD>(static_cast<long long>(x12 % MOD)) + Zn<MOD>(static_cast<long long>(t2)) * p1p2_mod;
+        }
+        return c;
+    }
+}
+
+/*
+int main()
+{
+    using mint = cp::Zn<998244353>;
+
+    std::vector<mint> a = {1, 2, 3}, b = {4, 5};
+    for (mint x : cp::convolve(a, b))
+        std::cout << x << " "; // 4 13 22 15
+    std::cout << std::endl;
+
+    // Any modulus, prime or not, through the three-prime CRT fallback
+    using zint = cp::Zn<1000000007>;
+    std::vector<zint> c(100000, 1000000006), d(100000, 1000000006);
+    std::cout << cp::convolve_arbitrary(c, d)[99999] << std::endl; // 100000
+}
+*/
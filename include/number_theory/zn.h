@@ -1,6 +1,9 @@
 #pragma once
 
 #include <iostream>
+#include <bit>
+
+#include "../debug/stats.h"
 
 namespace cp
 {
@@ -9,7 +12,9 @@ namespace cp
      *
      * This struct encapsulates an integer and performs all arithmetic operations
      * under the modulus `MOD`. The modulus is a compile-time constant, which
-     * allows for significant compiler optimizations and type safety.
+     * allows for significant compiler optimizations and type safety. All
+     * arithmetic is `constexpr`, so tables of `Zn` values can be built at
+     * compile time.
      *
      * @tparam MOD The modulus. Must be a positive integer.
      */
@@ -19,9 +24,8 @@ namespace cp
         int value;
 
         /// @brief Default constructor, initializes value to 0.
-        Zn(long long v = 0)
+        constexpr Zn(long long v = 0) : value(static_cast<int>(v % MOD))
         {
-            value = v % MOD;
             if (value < 0)
                 value += MOD;
         }
@@ -33,7 +37,7 @@ namespace cp
          * @note This requires the modulus `MOD` to be a prime number.
          * @return The modular inverse as a `Zn` object.
          */
-        Zn inverse() const
+        constexpr Zn inverse() const
         {
             return power(MOD - 2);
         }
@@ -43,8 +47,9 @@ namespace cp
          * @param exp The exponent.
          * @return The result of (this->value ^ exp) % MOD.
          */
-        Zn power(long long exp) const
+        constexpr Zn power(long long exp) const
         {
+            CP_STAT("Zn::power", exp > 0 ? std::bit_width(static_cast<unsigned long long>(exp)) : 0);
             Zn res = 1, base = *this;
             while (exp > 0)
             {
@@ -57,7 +62,7 @@ namespace cp
         }
 
         /// @brief Adds another Zn value to this one.
-        Zn &operator+=(const Zn &other)
+        constexpr Zn &operator+=(const Zn &other)
         {
             value += other.value;
             if (value >= MOD)
@@ -66,7 +71,7 @@ namespace cp
         }
 
         /// @brief Subtracts another Zn value from this one.
-        Zn &operator-=(const Zn &other)
+        constexpr Zn &operator-=(const Zn &other)
         {
             value -= other.value;
             if (value < 0)
@@ -75,29 +80,29 @@ namespace cp
         }
 
         /// @brief Multiplies this Zn value by another one.
-        Zn &operator*=(const Zn &other)
+        constexpr Zn &operator*=(const Zn &other)
         {
             value = static_cast<int>((static_cast<long long>(value) * other.value) % MOD);
             return *this;
         }
 
         /// @brief Divides this Zn value by another one.
-        Zn &operator/=(const Zn &other)
+        constexpr Zn &operator/=(const Zn &other)
         {
             return *this *= other.inverse();
         }
 
         /// @brief Unary negation operator.
-        Zn operator-() const { return Zn(-value); }
+        constexpr Zn operator-() const { return Zn(-value); }
 
         // Friend functions for binary and stream operators
-        friend Zn operator+(Zn a, const Zn &b) { return a += b; }
-        friend Zn operator-(Zn a, const Zn &b) { return a -= b; }
-        friend Zn operator*(Zn a, const Zn &b) { return a *= b; }
-        friend Zn operator/(Zn a, const Zn &b) { return a /= b; }
+        friend constexpr Zn operator+(Zn a, const Zn &b) { return a += b; }
+        friend constexpr Zn operator-(Zn a, const Zn &b) { return a -= b; }
+        friend constexpr Zn operator*(Zn a, const Zn &b) { return a *= b; }
+        friend constexpr Zn operator/(Zn a, const Zn &b) { return a /= b; }
 
-        friend bool operator==(const Zn &a, const Zn &b) { return a.value == b.value; }
-        friend bool operator!=(const Zn &a, const Zn &b) { return a.value != b.value; }
+        friend constexpr bool operator==(const Zn &a, const Zn &b) { return a.value == b.value; }
+        friend constexpr bool operator!=(const Zn &a, const Zn &b) { return a.value != b.value; }
 
         friend std::ostream &operator<<(std::ostream &os, const Zn &z) { return os << z.value; }
         friend std::istream &operator>>(std::istream &is, Zn &z)
@@ -109,7 +114,7 @@ namespace cp
         }
 
         /// @brief Explicit conversion to the underlying integer type.
-        explicit operator int() const { return value; }
+        explicit constexpr operator int() const { return value; }
     };
 }
 
@@ -139,4 +144,4 @@ int main()
 
     std::cout << "Equality check (f == c): " << std::boolalpha << (f == c) << std::endl;
 }
-/**/
\ No newline at end of file
+*/
\ No newline at end of file
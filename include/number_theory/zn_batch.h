@@ -0,0 +1,252 @@
+#pragma once
+/*
+ * Batch (element-wise) kernels over arrays of Zn
+ * Operation: O(n) mul_inplace(a, b)      a[i] = a[i] * b[i]
+ * Operation: O(n) fma(a, b, c)           a[i] = a[i] * b[i] + c[i]
+ * Operation: O(n) prefix_product(a)      a[i] = a[0] * a[1] * ... * a[i]
+ * Operation: O(n log e) pointwise_pow(a, e) a[i] = a[i] ^ e
+ *
+ * With AVX2 (-mavx2 or -march=native) and an odd MOD, eight residues are
+ * processed per instruction using Montgomery multiplication in 32-bit lanes.
+ * Otherwise, and for the tail of every span, the portable scalar Zn path runs.
+ */
+
+#include <span>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "zn.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace cp
+{
+    namespace batch
+    {
+        namespace detail
+        {
+#if defined(__AVX2__)
+            template <int MOD>
+            inline constexpr bool use_simd =
+                MOD % 2 == 1 && sizeof(Zn<MOD>) == sizeof(std::uint32_t) && std::is_standard_layout_v<Zn<MOD>>;
+
+            /**
+             * @brief Montgomery arithmetic for eight 32-bit residues at once.
+             *
+             * Uses R = 2^32. `mul(a, b)` returns a * b * R^{-1} mod MOD for lane
+             * values in [0, MOD); multiplying by R^2 mod MOD afterwards converts
+             * the result back to the normal representation.
+             */
+            template <int MOD>
+            struct Lanes
+            {
+                static constexpr std::uint32_t inverse()
+                {
+                    std::uint32_t inv = MOD; // correct to 3 bits for odd MOD
+                    for (int i = 0; i < 5; ++i)
+                        inv *= 2u - static_cast<std::uint32_t>(MOD) * inv;
+                    return inv;
+                }
+
+                static constexpr std::uint32_t N_INV = inverse();
+                static constexpr std::uint32_t R1 = static_cast<std::uint32_t>((1ULL << 32) % MOD);
+                static constexpr std::uint32_t R2 = static_cast<std::uint32_t>(1ULL * R1 * R1 % MOD);
+
+                __m256i mod = _mm256_set1_epi32(MOD);
+                __m256i n_inv = _mm256_set1_epi32(static_cast<int>(N_INV));
+                __m256i r1 = _mm256_set1_epi32(static_cast<int>(R1));
+                __m256i r2 = _mm256_set1_epi32(static_cast<int>(R2));
+                __m256i one = _mm256_set1_epi32(1);
+
+                static __m256i load(const Zn<MOD> *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+                static void store(Zn<MOD> *p, __m256i v) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v); }
+
+                __m256i mul(__m256i a, __m256i b) const
+                {
+                    __m256i p_even = _mm256_mul_epu32(a, b);
+                    __m256i p_odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+                    __m256i m_even = _mm256_mul_epu32(_mm256_mul_epu32(p_even, n_inv), mod);
+                    __m256i m_odd = _mm256_mul_epu32(_mm256_mul_epu32(p_odd, n_inv), mod);
+                    // The low halves of p and m agree, so (p - m) / 2^32 = hi(p) - hi(m).
+                    __m256i p_hi = _mm256_blend_epi32(_mm256_srli_epi64(p_even, 32), p_odd, 0b10101010);
+                    __m256i m_hi = _mm256_blend_epi32(_mm256_srli_epi64(m_even, 32), m_odd, 0b10101010);
+                    __m256i r = _mm256_sub_epi32(p_hi, m_hi); // in (-MOD, MOD)
+                    return _mm256_min_epu32(r, _mm256_add_epi32(r, mod));
+                }
+
+                /// @brief Multiplies two vectors of residues in normal representation.
+                __m256i mul_normal(__m256i a, __m256i b) const { return mul(mul(a, b), r2); }
+
+                __m256i add(__m256i a, __m256i b) const
+                {
+                    __m256i s = _mm256_add_epi32(a, b);
+                    return _mm256_min_epu32(s, _mm256_sub_epi32(s, mod));
+                }
+
+                __m256i to_mont(__m256i a) const { return mul(a, r2); }
+                __m256i from_mont(__m256i a) const { return mul(a, one); }
+
+                /// @brief Shifts lanes up by `k` (k = 1, 2, 4), filling with Montgomery one.
+                template <int k>
+                __m256i shift_in_one(__m256i a) const
+                {
+                    const __m256i idx = k == 1   ? _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6)
+                                        : k == 2 ? _mm256_setr_epi32(0, 0, 0, 1, 2, 3, 4, 5)
+                                                 : _mm256_setr_epi32(0, 0, 0, 0, 0, 1, 2, 3);
+                    return _mm256_blend_epi32(_mm256_permutevar8x32_epi32(a, idx), r1, (1 << k) - 1);
+                }
+            };
+#endif
+        }
+
+        /**
+         * @brief Element-wise multiplication: a[i] *= b[i].
+         * @param a The destination span.
+         * @param b The multipliers. Must have at least a.size() elements.
+         * @complexity O(n)
+         */
+        template <int MOD>
+        void mul_inplace(std::span<Zn<MOD>> a, std::type_identity_t<std::span<const Zn<MOD>>> b)
+        {
+            size_t i = 0, n = a.size();
+#if defined(__AVX2__)
+            if constexpr (detail::use_simd<MOD>)
+            {
+                const detail::Lanes<MOD> L;
+                for (; i + 8 <= n; i += 8)
+                    L.store(&a[i], L.mul_normal(L.load(&a[i]), L.load(&b[i])));
+            }
+#endif
+            for (; i < n; ++i)
+                a[i] *= b[i];
+        }
+
+        /**
+         * @brief Element-wise fused multiply-add: a[i] = a[i] * b[i] + c[i].
+         * @param a The destination span.
+         * @param b The multipliers. Must have at least a.size() elements.
+         * @param c The addends. Must have at least a.size() elements.
+         * @complexity O(n)
+         */
+        template <int MOD>
+        void fma(std::span<Zn<MOD>> a, std::type_identity_t<std::span<const Zn<MOD>>> b,
+                 std::type_identity_t<std::span<const Zn<MOD>>> c)
+        {
+            size_t i = 0, n = a.size();
+#if defined(__AVX2__)
+            if constexpr (detail::use_simd<MOD>)
+            {
+                const detail::Lanes<MOD> L;
+                for (; i + 8 <= n; i += 8)
+                    L.store(&a[i], L.add(L.mul_normal(L.load(&a[i]), L.load(&b[i])), L.load(&c[i])));
+            }
+#endif
+            for (; i < n; ++i)
+                a[i] = a[i] * b[i] + c[i];
+        }
+
+        /**
+         * @brief In-place inclusive prefix product: a[i] = a[0] * ... * a[i].
+         *
+         * The SIMD path computes a log-step scan inside each block of eight
+         * lanes and carries the running product between blocks, so only one
+         * multiplication per block sits on the serial dependency chain.
+         * @complexity O(n)
+         */
+        template <int MOD>
+        void prefix_product(std::span<Zn<MOD>> a)
+        {
+            size_t i = 0, n = a.size();
+            Zn<MOD> carry = 1;
+#if defined(__AVX2__)
+            if constexpr (detail::use_simd<MOD>)
+            {
+                const detail::Lanes<MOD> L;
+                __m256i run = L.r1; // running product, Montgomery form, broadcast
+                const __m256i last = _mm256_set1_epi32(7);
+                for (; i + 8 <= n; i += 8)
+                {
+                    __m256i x = L.to_mont(L.load(&a[i]));
+                    x = L.mul(x, L.template shift_in_one<1>(x));
+                    x = L.mul(x, L.template shift_in_one<2>(x));
+                    x = L.mul(x, L.template shift_in_one<4>(x));
+                    x = L.mul(x, run);
+                    run = _mm256_permutevar8x32_epi32(x, last);
+                    L.store(&a[i], L.from_mont(x));
+                }
+                if (i > 0)
+                    carry = a[i - 1];
+            }
+#endif
+            for (; i < n; ++i)
+                a[i] = carry *= a[i];
+        }
+
+        /**
+         * @brief Raises every element to the same power: a[i] = a[i] ^ exp.
+         * @param a The span to update.
+         * @param exp The non-negative exponent shared by all elements.
+         * @complexity O(n log exp)
+         */
+        template <int MOD>
+        void pointwise_pow(std::span<Zn<MOD>> a, long long exp)
+        {
+            size_t i = 0, n = a.size();
+#if defined(__AVX2__)
+            if constexpr (detail::use_simd<MOD>)
+            {
+                const detail::Lanes<MOD> L;
+                for (; i + 8 <= n; i += 8)
+                {
+                    __m256i base = L.to_mont(L.load(&a[i])), res = L.r1;
+                    for (long long e = exp; e > 0; e >>= 1)
+                    {
+                        if (e & 1)
+                            res = L.mul(res, base);
+                        base = L.mul(base, base);
+                    }
+                    L.store(&a[i], L.from_mont(res));
+                }
+            }
+#endif
+            for (; i < n; ++i)
+                a[i] = a[i].power(exp);
+        }
+
+        // std::vector convenience overloads (span parameters do not deduce MOD from a vector).
+        template <int MOD>
+        void mul_inplace(std::vector<Zn<MOD>> &a, const std::vector<Zn<MOD>> &b) { mul_inplace<MOD>(std::span(a), b); }
+
+        template <int MOD>
+        void fma(std::vector<Zn<MOD>> &a, const std::vector<Zn<MOD>> &b, const std::vector<Zn<MOD>> &c) { fma<MOD>(std::span(a), b, c); }
+
+        template <int MOD>
+        void prefix_product(std::vector<Zn<MOD>> &a) { prefix_product<MOD>(std::span(a)); }
+
+        template <int MOD>
+        void pointwise_pow(std::vector<Zn<MOD>> &a, long long exp) { pointwise_pow<MOD>(std::span(a), exp); }
+    }
+}
+
+/*
+int main()
+{
+    using mint = cp::Zn<998244353>;
+
+    std::vector<mint> a(10), b(10), c(10);
+    for (int i = 0; i < 10; ++i)
+        a[i] = i + 1, b[i] = 2, c[i] = 1;
+
+    cp::batch::fma(a, b, c); // a = {3, 5, 7, ..., 21}
+    cp::batch::prefix_product(a); // a[i] = 3 * 5 * ... * (2i + 3)
+    cp::batch::pointwise_pow(a, 998244352); // Fermat: every a[i] becomes 1
+
+    for (mint x : a)
+        std::cout << x << " ";
+    std::cout << std::endl;
+}
+*/
@@ -0,0 +1,191 @@
+#pragma once
+/*
+ * Dense matrix arithmetic over Zn, stored in 2D NDArrays
+ * Operation: O(n m k) matmul(A, B)        (n x k) * (k x m)
+ * Operation: O(n^3 log e) matpow(A, e)    A ^ e for square A
+ * Operation: O(n^2) identity<MOD>(n)
+ */
+
+// matmul never calls Zn::operator*. Both operands are first packed into plain
+// 32-bit residues: A row by row and B transposed, so every entry of the result
+// is a dot product of two contiguous rows. The dot product adds raw 64-bit
+// products and takes one `%` per REDUCE_EVERY terms (about 16 for 30-bit
+// moduli) instead of one per term. Output tiles of TILE x TILE keep the B rows
+// they touch in cache while they are reused across TILE rows of A.
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+
+#include "zn.h"
+#include "../data_structures/ndarray.h"
+
+namespace cp
+{
+    namespace matrix
+    {
+        namespace detail
+        {
+            /// @brief How many products below MOD^2 can be added to a residue before a u64 overflows.
+            template <int MOD>
+            inline constexpr size_t REDUCE_EVERY = MOD == 1
+                                                       ? SIZE_MAX
+                                                       : static_cast<size_t>((UINT64_MAX - (MOD - 1)) / (static_cast<std::uint64_t>(MOD - 1) * (MOD - 1)));
+
+            inline constexpr size_t TILE = 32;
+
+            /// @brief Copies a 2D Zn array into a dense row-major residue buffer, optionally transposed.
+            template <int MOD, typename Alloc>
+            std::vector<std::uint32_t> pack(const NDArray<Zn<MOD>, Alloc> &a, bool transpose)
+            {
+                size_t rows = a.shape()[0], cols = a.shape()[1], pitch = a.strides()[0];
+                const Zn<MOD> *src = a.data();
+                std::vector<std::uint32_t> out(rows * cols);
+                for (size_t i = 0; i < rows; ++i)
+                {
+                    for (size_t j = 0; j < cols; ++j)
+                    {
+                        out[transpose ? j * rows + i : i * cols + j] = static_cast<std::uint32_t>(src[i * pitch + j].value);
+                    }
+                }
+                return out;
+            }
+
+            /// @brief Returns sum(a[t] * b[t]) mod MOD over t in [0, k).
+            template <int MOD>
+            std::uint32_t dot(const std::uint32_t *a, const std::uint32_t *b, size_t k)
+            {
+                std::uint64_t acc = 0;
+                size_t t = 0;
+                while (t < k)
+                {
+                    size_t stop = std::min(k, t + REDUCE_EVERY<MOD>);
+                    std::uint64_t s = 0;
+                    for (; t < stop; ++t)
+                    {
+                        s += static_cast<std::uint64_t>(a[t]) * b[t];
+                    }
+                    acc = (acc + s) % MOD;
+                }
+                return static_cast<std::uint32_t>(acc);
+            }
+
+            inline void check_2d(const std::vector<size_t> &shape, const char *what)
+            {
+                if (shape.size() != 2)
+                {
+                    throw std::invalid_argument(std::string(what) + " must be a 2D array.");
+                }
+            }
+        }
+
+        /// @brief Returns the n x n identity matrix.
+        template <int MOD>
+        NDArray<Zn<MOD>> identity(size_t n)
+        {
+            NDArray<Zn<MOD>> id({n, n});
+            for (size_t i = 0; i < n; ++i)
+            {
+                id(i, i) = Zn<MOD>(1);
+            }
+            return id;
+        }
+
+        /**
+         * @brief Multiplies an (n x k) matrix by a (k x m) matrix.
+         * @param A The left operand, a 2D array (padded rows are fine).
+         * @param B The right operand, a 2D array whose row count equals A's column count.
+         * @return The (n x m) product.
+         * @complexity O(n m k), with one modular reduction per REDUCE_EVERY multiply-adds.
+         */
+        template <int MOD, typename AllocA, typename AllocB>
+        NDArray<Zn<MOD>> matmul(const NDArray<Zn<MOD>, AllocA> &A, const NDArray<Zn<MOD>, AllocB> &B)
+        {
+            detail::check_2d(A.shape(), "matmul: A");
+            detail::check_2d(B.shape(), "matmul: B");
+            size_t n = A.shape()[0], k = A.shape()[1], m = B.shape()[1];
+            if (B.shape()[0] != k)
+            {
+                throw std::invalid_argument("matmul: inner dimensions do not match.");
+            }
+
+            std::vector<std::uint32_t> a = detail::pack(A, false);
+            std::vector<std::uint32_t> bt = detail::pack(B, true);
+            NDArray<Zn<MOD>> C({n, m}, ndarray_uninitialized);
+            Zn<MOD> *c = C.data();
+
+            for (size_t i0 = 0; i0 < n; i0 += detail::TILE)
+            {
+                size_t i1 = std::min(n, i0 + detail::TILE);
+                for (size_t j0 = 0; j0 < m; j0 += detail::TILE)
+                {
+                    size_t j1 = std::min(m, j0 + detail::TILE);
+                    for (size_t i = i0; i < i1; ++i)
+                    {
+                        const std::uint32_t *row = a.data() + i * k;
+                        for (size_t j = j0; j < j1; ++j)
+                        {
+                            c[i * m + j].value = static_cast<int>(detail::dot<MOD>(row, bt.data() + j * k, k));
+                        }
+                    }
+                }
+            }
+            return C;
+        }
+
+        /**
+         * @brief Raises a square matrix to a non-negative power.
+         * @param A The square matrix.
+         * @param exp The exponent; A^0 is the identity.
+         * @complexity O(n^3 log exp)
+         */
+        template <int MOD, typename Alloc>
+        NDArray<Zn<MOD>> matpow(const NDArray<Zn<MOD>, Alloc> &A, long long exp)
+        {
+            detail::check_2d(A.shape(), "matpow: A");
+            size_t n = A.shape()[0];
+            if (A.shape()[1] != n)
+            {
+                throw std::invalid_argument("matpow: matrix must be square.");
+            }
+            if (exp < 0)
+            {
+                throw std::invalid_argument("matpow: exponent must be non-negative.");
+            }
+
+            NDArray<Zn<MOD>> result = identity<MOD>(n);
+            NDArray<Zn<MOD>> base = A.view().copy();
+            while (exp > 0)
+            {
+                if (exp & 1)
+                    result = matmul(result, base);
+                exp >>= 1;
+                if (exp > 0)
+                    base = matmul(base, base);
+            }
+            return result;
+        }
+    }
+}
+
+/*
+int main()
+{
+    using mint = cp::Zn<1000000007>;
+
+    // Fibonacci: [[1, 1], [1, 0]]^n = [[F(n+1), F(n)], [F(n), F(n-1)]]
+    NDArray<mint> fib({2, 2});
+    fib(0, 0) = 1, fib(0, 1) = 1, fib(1, 0) = 1;
+    std::cout << cp::matrix::matpow(fib, 90)(0, 1) << std::endl; // F(90) mod 1e9+7 = 210345902
+
+    // Paths of length 3 in a directed 3-cycle with self-loops.
+    NDArray<mint> adj({3, 3});
+    for (size_t i = 0; i < 3; ++i)
+        adj(i, i) = 1, adj(i, (i + 1) % 3) = 1;
+    std::cout << cp::matrix::matmul(adj, cp::matrix::matmul(adj, adj)) << std::endl; // [[2, 3, 3], [3, 2, 3], [3, 3, 2]]
+    return 0;
+}
+*/
@@ -4,6 +4,7 @@ import sys
 import os
 import re
 import json
+import hashlib
 import argparse
 import shutil
 import stat
@@ -41,42 +42,526 @@ def install_script():
         print(f"❌ An error occurred during installation: {e}")
         sys.exit(1)
 
-# --- New Recursive Inlining Logic ---
-def recursively_inline(header_path, seen_files):
+# --- Lexing Helpers ---
+
+# Code is split into literals, comments and everything else in one pass before
+# any regex touches it, so comment markers, whitespace and operators inside
+# "..." or '...' survive, and quotes inside comments start no literal.
+INCLUDE_RE = re.compile(r'^\s*#\s*include\s*"([^"]+)"')
+IDENTIFIER_RE = re.compile(r'[A-Za-z_]\w*')
+RAW_PREFIX_RE = re.compile(r'(?<![\w])(?:u8|[uUL])?R$')
+
+def scan_source(text):
+    """Splits text into ("code" | "literal" | "comment", chunk) pieces."""
+    pieces, i, code_start, n = [], 0, 0, len(text)
+
+    def emit(kind, start, end):
+        nonlocal code_start
+        if start > code_start: pieces.append(("code", text[code_start:start]))
+        pieces.append((kind, text[start:end]))
+        code_start = end
+
+    while i < n:
+        c = text[i]
+        if c == '/' and text.startswith('//', i):
+            end = text.find('\n', i)
+            end = n if end == -1 else end
+            emit("comment", i, end)
+            i = end
+        elif c == '/' and text.startswith('/*', i):
+            end = text.find('*/', i + 2)
+            end = n if end == -1 else end + 2
+            emit("comment", i, end)
+            i = end
+        elif c == '"' or c == "'":
+            before = text[code_start:i]
+            run = re.search(r"[\w']*$", before).group(0)
+            if c == "'" and run[:1].isdigit():
+                i += 1  # 1'000'000: a digit separator
+                continue
+            raw = RAW_PREFIX_RE.search(before) if c == '"' else None
+            if raw:
+                open_paren = text.find('(', i)
+                delimiter = text[i + 1:open_paren] if open_paren != -1 else ''
+                close = text.find(')' + delimiter + '"', open_paren + 1) if open_paren != -1 else -1
+                end = n if close == -1 else close + len(delimiter) + 2
+                emit("literal", i - len(raw.group(0)), end)
+            else:
+                j = i + 1
+                while j < n and text[j] != c and text[j] != '\n':
+                    j += 2 if text[j] == '\\' else 1
+                end = min(j + 1, n)
+                emit("literal", i, end)
+            i = end
+        else:
+            i += 1
+    if code_start < n: pieces.append(("code", text[code_start:]))
+    return pieces
+
+def split_literals(text):
+    """Splits comment-free text into (is_literal, chunk) pieces."""
+    return [(kind == "literal", chunk) for kind, chunk in scan_source(text)]
+
+MEMBER_ACCESS_RE = re.compile(r'(?:(?<!\.)\.|->)\s*$')
+
+def code_identifiers(text):
+    """Returns every identifier outside literals, except member names (x.size, p->next)."""
+    found = set()
+    for is_literal, chunk in split_literals(text):
+        if is_literal: continue
+        for match in IDENTIFIER_RE.finditer(chunk):
+            before = chunk[max(0, match.start() - 32):match.start()]
+            if not MEMBER_ACCESS_RE.search(before): found.add(match.group(0))
+    return found
+
+def logical_lines(content):
+    """Splits content into lines, joining backslash-continued lines (multi-line macros) into one."""
+    lines, pending = [], ""
+    for line in content.splitlines():
+        if line.rstrip().endswith('\\'):
+            pending += line.rstrip()[:-1] + " "
+            continue
+        lines.append(pending + line)
+        pending = ""
+    if pending: lines.append(pending)
+    return lines
+
+# --- Header Preprocessing & Cache ---
+
+def script_digest():
+    """Hashes this script, so entries written by another version of the inliner are never reused."""
+    try:
+        with open(os.path.abspath(__file__), 'rb') as f:
+            return hashlib.sha256(f.read()).hexdigest()
+    except IOError:
+        return ""
+
+SCRIPT_DIGEST = script_digest()
+
+class HeaderCache:
     """
-    Recursively reads a header file and all its local #include directives,
-    returning a single string with all content flattened.
+    A content-addressed cache in <output_dir>/.inliner_cache. Entries are keyed
+    by the SHA-256 of everything that determines them, so an edited header or a
+    changed option simply misses; nothing is ever invalidated by hand.
     """
-    abs_header_path = os.path.abspath(header_path)
+    def __init__(self, output_dir, enabled=True):
+        self.enabled = enabled
+        self.directory = os.path.join(output_dir, '.inliner_cache')
+        self.hits = self.misses = 0
+        if enabled: os.makedirs(self.directory, exist_ok=True)
 
-    if abs_header_path in seen_files:
-        return "" 
-    seen_files.add(abs_header_path)
+    @staticmethod
+    def key(*parts):
+        digest = hashlib.sha256(SCRIPT_DIGEST.encode())
+        for part in parts:
+            digest.update(b'\0' + (part if isinstance(part, bytes) else str(part).encode()))
+        return digest.hexdigest()
+
+    def load(self, kind, key):
+        if not self.enabled: return None
+        try:
+            with open(os.path.join(self.directory, f"{kind}-{key}.json"), 'r') as f:
+                value = json.load(f)
+            self.hits += 1
+            return value
+        except (IOError, ValueError):
+            self.misses += 1
+            return None
 
+    def store(self, kind, key, value):
+        if not self.enabled: return
+        path = os.path.join(self.directory, f"{kind}-{key}.json")
+        temp_path = f"{path}.{os.getpid()}.tmp"
+        with open(temp_path, 'w') as f:
+            json.dump(value, f)
+        os.replace(temp_path, path)  # atomic: concurrent runs never read half an entry
+
+def preprocess_header(abs_path, cache):
+    """
+    Reads one header and returns {"digest", "lines", "includes"}: its lines with
+    comments, blank lines and '#pragma once' removed and continuations joined.
+    Local '#include "..."' lines are kept in place for the caller to expand.
+    Returns None if the file does not exist.
+    """
     try:
-        with open(abs_header_path, 'r') as f:
-            content = f.read()
-    except FileNotFoundError:
+        with open(abs_path, 'rb') as f:
+            raw = f.read()
+    except (FileNotFoundError, IsADirectoryError):
+        return None
+
+    digest = HeaderCache.key('header', raw)
+    entry = cache.load('header', digest)
+    if entry is None:
+        lines, includes = [], []
+        for line in logical_lines(strip_comments(raw.decode('utf-8', errors='replace'))):
+            stripped = line.strip()
+            if not stripped or re.match(r'#\s*pragma\s+once\b', stripped): continue
+            match = INCLUDE_RE.match(stripped)
+            if match: includes.append(match.group(1))
+            lines.append(stripped)
+        entry = {"lines": lines, "includes": includes}
+        cache.store('header', digest, entry)
+    entry["digest"] = digest
+    return entry
+
+def build_dependency_graph(header_path, seen_files, cache, graph):
+    """
+    Walks the local includes of header_path depth-first and records every newly
+    reached file in graph (abs path -> preprocessed entry, in first-visit order).
+    seen_files is shared by all marked includes of one source file, so a header
+    reached twice (e.g. chash.h through two data structures) is emitted once.
+    """
+    abs_header_path = os.path.abspath(header_path)
+    if abs_header_path in seen_files: return
+    seen_files.add(abs_header_path)
+
+    entry = preprocess_header(abs_header_path, cache)
+    if entry is None:
         print(f"    [WARNING] Header not found: '{header_path}'. Skipping.")
-        return ""
+        return
+    graph[abs_header_path] = entry
+    header_dir = os.path.dirname(abs_header_path)
+    for included_header_name in entry["includes"]:
+        print(f"        -> Found nested header: '{included_header_name}'")
+        build_dependency_graph(os.path.join(header_dir, included_header_name), seen_files, cache, graph)
+
+def recursively_inline(header_path, emitted, graph):
+    """
+    Returns the lines of header_path with each local include replaced by the
+    lines of that header, in place, the first time it is reached.
+    """
+    abs_header_path = os.path.abspath(header_path)
+    if abs_header_path in emitted or abs_header_path not in graph: return []
+    emitted.add(abs_header_path)
 
     processed_lines = []
     header_dir = os.path.dirname(abs_header_path)
-
-    for line in content.splitlines():
-        match = re.search(r'^\s*#include "([^"]+)"', line)
+    for line in graph[abs_header_path]["lines"]:
+        match = INCLUDE_RE.match(line)
         if match:
-            included_header_name = match.group(1)
-            next_header_path = os.path.join(header_dir, included_header_name)
-            
-            print(f"        -> Found and processing nested header: '{included_header_name}'")
-            inlined_content = recursively_inline(next_header_path, seen_files)
-            processed_lines.append(inlined_content)
+            processed_lines.extend(recursively_inline(os.path.join(header_dir, match.group(1)), emitted, graph))
         else:
-            if line.strip() != '#pragma once':
-                processed_lines.append(line)
-            
-    return "\n".join(processed_lines)
+            processed_lines.append(line)
+    return processed_lines
+
+# --- Tree Shaking (opt-in) ---
+
+# The inlined headers are split into top-level declarations (descending into
+# namespaces): classes, functions, aliases and variables, each with the names
+# it declares and the identifiers it mentions. Starting from the identifiers of
+# the user's source and of every preprocessor line, a declaration is kept once
+# one of its names is reachable, and everything it mentions becomes reachable.
+# Declarations without a usable name (free operators, specializations of
+# std::hash) are kept when they mention something kept, following the helpers
+# they call (is_operand_v<L> -> is_ndarray, but not into classes), or nothing
+# from the headers at all (using namespace std;). Matching is by bare name, so a
+# collision only ever keeps too much. Preprocessor lines are never removed, and
+# only the first branch of an #if chain is parsed; the identifiers of the other
+# branches count as reachable.
+
+CPP_KEYWORDS = {
+    'alignas', 'alignof', 'auto', 'bool', 'char', 'class', 'concept', 'const', 'consteval', 'constexpr',
+    'constinit', 'decltype', 'double', 'enum', 'explicit', 'extern', 'float', 'friend', 'inline', 'int',
+    'long', 'mutable', 'noexcept', 'operator', 'requires', 'short', 'signed', 'sizeof', 'static',
+    'static_assert', 'struct', 'template', 'thread_local', 'typedef', 'typename', 'union', 'unsigned',
+    'using', 'virtual', 'void', 'volatile', '__attribute__', '__declspec',
+}
+CLASS_KEYS = {'class', 'struct', 'union', 'enum'}
+CALL_LIKE = {'decltype', 'alignas', 'alignof', '__attribute__', '__declspec', 'sizeof', 'noexcept', 'requires'}
+TOKEN_RE = re.compile(r'[A-Za-z_]\w*|\d[\w.\']*|::|\S')
+
+class Token:
+    __slots__ = ('text', 'is_id', 'line', 'start', 'end')
+
+    def __init__(self, text, is_id, line, start, end):
+        self.text, self.is_id, self.line, self.start, self.end = text, is_id, line, start, end
+
+class Unit:
+    """A top-level declaration (or a namespace, when children is not None) spanning tokens [first, last]."""
+    def __init__(self, first, last, names=(), refs=(), children=None, is_class=False):
+        self.first, self.last = first, last
+        self.names, self.refs, self.children = set(names), set(refs), children
+        self.is_class, self.kept = is_class, False
+
+def tokenize_lines(lines):
+    """Tokenizes the code lines; returns (tokens, identifiers of the lines it did not parse)."""
+    tokens, unparsed, branches = [], set(), []
+    for line_index, line in enumerate(lines):
+        directive = re.match(r'#\s*(\w+)', line)
+        if directive:
+            word = directive.group(1)
+            if word in ('if', 'ifdef', 'ifndef'): branches.append(False)
+            elif word in ('elif', 'else') and branches: branches[-1] = True
+            elif word == 'endif' and branches: branches.pop()
+            unparsed.update(code_identifiers(line))
+            continue
+        if any(branches):
+            unparsed.update(code_identifiers(line))
+            continue
+        position = 0
+        for is_literal, chunk in split_literals(line):
+            if is_literal:
+                tokens.append(Token(chunk, False, line_index, position, position + len(chunk)))
+            else:
+                for match in TOKEN_RE.finditer(chunk):
+                    text = match.group(0)
+                    is_id = bool(IDENTIFIER_RE.fullmatch(text))
+                    tokens.append(Token(text, is_id, line_index, position + match.start(), position + match.end()))
+            position += len(chunk)
+    return tokens, unparsed
+
+def skip_template_prefix(texts, k):
+    """Skips 'template <...>' groups (and a bare 'template' of an explicit instantiation) starting at k."""
+    while k < len(texts) and texts[k] == 'template':
+        k += 1
+        if k < len(texts) and texts[k] == '<':
+            depth = 0
+            while k < len(texts):
+                if texts[k] in '<(': depth += 1
+                elif texts[k] in '>)': depth -= 1
+                k += 1
+                if depth == 0: break
+    return k
+
+def operator_end(texts, m):
+    """For 'operator' at m, returns the index of the '(' opening its parameter list."""
+    m += 1
+    if texts[m:m + 2] == ['(', ')']: return m + 2
+    while m < len(texts) and texts[m] != '(': m += 1
+    return m
+
+def head_stop(texts, k, stops):
+    """Returns the first index >= k of a token in stops outside (), [], <> and operator names."""
+    depth, m = 0, k
+    while m < len(texts):
+        t = texts[m]
+        if t == 'operator':
+            m = operator_end(texts, m)
+            continue
+        if depth == 0 and t in stops and not (t == '(' and m > 0 and texts[m - 1] in CALL_LIKE):
+            return m
+        if t in ('(', '[', '<'): depth += 1
+        elif t in (')', ']', '>') and depth > 0: depth -= 1
+        m += 1
+    return len(texts)
+
+def is_assignment(texts, m):
+    return texts[m] == '=' and texts[m - 1] not in ('operator', '=', '!', '<', '>', '+', '-', '*', '/', '%', '&', '|', '^') \
+        and (m + 1 >= len(texts) or texts[m + 1] != '=')
+
+def owner_name(texts, k):
+    """For the last identifier of a qualified name at k, returns the class that owns it (Foo in Foo<T>::bar), else itself."""
+    if k > 0 and texts[k - 1] == '~': k -= 1
+    if k >= 2 and texts[k - 1] == '::':
+        j = k - 2
+        if texts[j] == '>':
+            depth = 0
+            while j >= 0:
+                if texts[j] == '>': depth += 1
+                elif texts[j] == '<': depth -= 1
+                j -= 1
+                if depth == 0: break
+        if j >= 0 and IDENTIFIER_RE.fullmatch(texts[j]): return texts[j]
+        return None
+    return texts[k]
+
+def declared_names(texts):
+    """Returns the names a declaration introduces, or an empty set when it has none to index it by."""
+    k = skip_template_prefix(texts, 0)
+    head = texts[k:]
+    if not head: return set()
+    while head and head[0] in ('inline', 'static', 'constexpr', 'extern', 'export', 'thread_local'):
+        head = head[1:]
+    if not head or head[0] == 'static_assert': return set()
+    if head[0] == 'using':
+        return {head[1]} if len(head) > 2 and head[2] == '=' else set()
+    if head[0] == 'typedef':
+        end = head_stop(head, 1, {';'})
+        if end + 1 < len(head) and head[end] != ';': return set()
+        ids = [t for t in head[:end] if IDENTIFIER_RE.fullmatch(t) and t not in CPP_KEYWORDS]
+        return {ids[-1]} if ids else set()
+    if head[0] in CLASS_KEYS:
+        m = 1
+        while m < len(head):
+            if head[m] in ('class', 'struct', 'final'): m += 1
+            elif head[m] in ('alignas', '__attribute__') and m + 1 < len(head) and head[m + 1] == '(':
+                m = head_stop(head, m + 2, {')'}) + 1
+            elif head[m] == '[' and m + 1 < len(head) and head[m + 1] == '[':
+                while m < len(head) and not (head[m] == ']' and m + 1 < len(head) and head[m + 1] == ']'): m += 1
+                m += 2
+            else: break
+        if m < len(head) and IDENTIFIER_RE.fullmatch(head[m]) and head[m] not in CPP_KEYWORDS:
+            if m + 1 < len(head) and head[m + 1] in ('<', '::'): return set()  # specialization
+            return {head[m]}
+        return set()
+
+    stop = head_stop(head, 0, {'(', '=', '{', ';', '['})
+    if stop < len(head) and head[stop] == '(':
+        k = stop - 1
+        if k >= 0 and head[k] == '>':  # f<int>(...): a function template specialization
+            depth = 0
+            while k >= 0:
+                if head[k] == '>': depth += 1
+                elif head[k] == '<': depth -= 1
+                k -= 1
+                if depth == 0: break
+        operator_at = next((j for j in range(k, max(k - 4, -1), -1) if head[j] == 'operator'), None)
+        if operator_at is not None:
+            owner = owner_name(head, operator_at) if operator_at >= 2 and head[operator_at - 1] == '::' else None
+            return {owner} if owner and owner != 'operator' else set()
+        if k < 0 or not IDENTIFIER_RE.fullmatch(head[k]): return set()
+        name = owner_name(head, k)
+    else:
+        ids = [j for j in range(stop) if IDENTIFIER_RE.fullmatch(head[j])]
+        if not ids: return set()
+        name = owner_name(head, ids[-1])
+    return {name} if name and name not in CPP_KEYWORDS else set()
+
+def declaration_end(tokens, i):
+    """Returns the index of the last token of the declaration starting at i."""
+    texts = tokens
+    depth, body_ends_it, head_end = 0, False, None
+    for k in range(i, len(tokens)):
+        t = texts[k].text
+        if t in ('(', '[', '{'):
+            if t == '{' and depth == 0 and head_end is None:
+                head_end = k
+                head = [tok.text for tok in tokens[i:k]]
+                j = skip_template_prefix(head, 0)
+                rest = head[j:]
+                while rest and rest[0] in ('inline', 'static', 'constexpr', 'extern'): rest = rest[1:]
+                assignment, m = False, head_stop(head, j, {'='})
+                while m < len(head) and not assignment:
+                    assignment = is_assignment(head, m)
+                    m = head_stop(head, m + 1, {'='})
+                body_ends_it = bool(rest) and rest[0] not in CLASS_KEYS and rest[0] != 'typedef' \
+                    and not assignment and ')' in rest
+            depth += 1
+        elif t in (')', ']', '}'):
+            if depth == 0: return k - 1  # the closing brace of the enclosing scope
+            depth -= 1
+            if t == '}' and depth == 0 and body_ends_it: return k
+        elif t == ';' and depth == 0:
+            return k
+    return len(tokens) - 1
+
+def is_member_name(tokens, k):
+    """True for the b of a.b and a->b: it is looked up in a's class, never among the declarations."""
+    adjacent = lambda x, y: tokens[x].line == tokens[y].line and tokens[x].end == tokens[y].start
+    if k >= 2 and tokens[k - 1].text == '.': return not (tokens[k - 2].text == '.' and adjacent(k - 2, k - 1))
+    return k >= 3 and tokens[k - 1].text == '>' and tokens[k - 2].text == '-' and adjacent(k - 2, k - 1) \
+        and not (tokens[k - 3].text == '-' and adjacent(k - 3, k - 2))
+
+def parse_scope(tokens, i):
+    """Parses declarations until the '}' closing the current scope; returns (units, index of that '}')."""
+    units = []
+    while i < len(tokens):
+        t = tokens[i].text
+        if t == '}': return units, i
+        if t == ';':
+            i += 1
+            continue
+        k = i + 1 if t == 'inline' and i + 1 < len(tokens) and tokens[i + 1].text == 'namespace' else i
+        opener = None
+        if tokens[k].text == 'namespace':
+            m = k + 1
+            while m < len(tokens) and tokens[m].text not in ('{', ';', '='): m += 1
+            if m < len(tokens) and tokens[m].text == '{': opener = m
+        elif t == 'extern' and i + 2 < len(tokens) and tokens[i + 1].text.startswith('"') and tokens[i + 2].text == '{':
+            opener = i + 2
+        if opener is not None:
+            children, close = parse_scope(tokens, opener + 1)
+            units.append(Unit(i, min(close, len(tokens) - 1), children=children))
+            i = close + 1
+            continue
+        last = max(declaration_end(tokens, i), i)
+        texts = [tok.text for tok in tokens[i:last + 1]]
+        refs = {tokens[k].text for k in range(i, last + 1) if tokens[k].is_id and not is_member_name(tokens, k)}
+        head = texts[skip_template_prefix(texts, 0):]
+        units.append(Unit(i, last, declared_names(texts), refs, is_class=bool(head) and head[0] in CLASS_KEYS))
+        i = last + 1
+    return units, i
+
+def all_declarations(units):
+    for unit in units:
+        if unit.children is None: yield unit
+        else: yield from all_declarations(unit.children)
+
+def mark_scopes(units):
+    """A namespace is kept if any declaration inside it is."""
+    for unit in units:
+        if unit.children is not None:
+            mark_scopes(unit.children)
+            unit.kept = any(child.kept for child in unit.children)
+
+def dropped_units(units):
+    for unit in units:
+        if not unit.kept: yield unit
+        elif unit.children is not None: yield from dropped_units(unit.children)
+
+def tree_shake(blocks, roots):
+    """
+    Removes the declarations of every block (a list of header lines) that the
+    roots cannot reach. Returns the shaken blocks and the number of removed declarations.
+    """
+    parsed = []
+    reachable = set(roots)
+    for lines in blocks:
+        tokens, unparsed = tokenize_lines(lines)
+        units, _ = parse_scope(tokens, 0)
+        reachable |= unparsed
+        parsed.append((lines, tokens, units))
+
+    declarations = [d for _, _, units in parsed for d in all_declarations(units)]
+    defined = set().union(*(d.names for d in declarations)) if declarations else set()
+    helpers = {}  # name -> what its non-class declarations mention
+    for d in declarations:
+        if not d.is_class:
+            for name in d.names: helpers.setdefault(name, set()).update(d.refs & defined)
+    for d in declarations:
+        if d.names: continue
+        d.triggers, stack = set(d.refs & defined), list(d.refs & defined)
+        while stack:
+            for name in helpers.get(stack.pop(), ()):
+                if name not in d.triggers:
+                    d.triggers.add(name)
+                    stack.append(name)
+    changed = True
+    while changed:
+        changed = False
+        for d in declarations:
+            if d.kept: continue
+            if d.names: keep = bool(d.names & reachable)
+            else: keep = not d.triggers or bool(d.triggers & reachable)
+            if keep:
+                d.kept, changed = True, True
+                reachable |= d.refs
+
+    shaken, removed = [], 0
+    for lines, tokens, units in parsed:
+        mark_scopes(units)
+        cuts = [[] for _ in lines]
+        is_code = [not re.match(r'\s*#', line) for line in lines]
+        for unit in dropped_units(units):
+            removed += sum(1 for _ in all_declarations([unit]))
+            first, last = tokens[unit.first], tokens[unit.last]
+            if first.line == last.line:
+                cuts[first.line].append((first.start, last.end))
+                continue
+            cuts[first.line].append((first.start, len(lines[first.line])))
+            for l in range(first.line + 1, last.line):
+                if is_code[l]: cuts[l].append((0, len(lines[l])))
+            cuts[last.line].append((0, last.end))
+        kept_lines = []
+        for line, line_cuts, code in zip(lines, cuts, is_code):
+            if code and line_cuts:
+                for start, end in sorted(line_cuts, reverse=True):
+                    line = line[:start] + line[end:]
+                line = line.strip()
+                if not line: continue
+            kept_lines.append(line)
+        shaken.append(kept_lines)
+    return shaken, removed
 
 # --- Core Application Logic ---
 
@@ -85,7 +570,9 @@ def load_config(config_path):
     defaults = {
         "output_dir": "build",
         "minify_style": "none",
-        "multiline_max_chars": 120
+        "multiline_max_chars": 120,
+        "cache": True,
+        "tree_shake": False
     }
     
     if config_path and os.path.exists(config_path):
@@ -122,85 +609,150 @@ def find_config_path(config_arg):
     return None
 
 def strip_comments(content):
-    """Removes C/C++ style comments from a string."""
-    content = re.sub(r'/\*.*?\*/', '', content, flags=re.DOTALL)
-    content = re.sub(r'//.*', '', content)
-    return content
+    """Removes C/C++ style comments from a string, leaving string and character literals untouched."""
+    pieces = []
+    for kind, chunk in scan_source(content):
+        # A comment becomes a space (a/**/b must not turn into ab) plus the newlines it spanned.
+        pieces.append(" " + "\n" * chunk.count("\n") if kind == "comment" else chunk)
+    return "".join(pieces)
+
+# Two characters that must keep a space between them: dropping it would merge
+# two tokens into one (a - -b, x * = y, vector<T> >= ...), start a comment or
+# form a digraph.
+TOKEN_HAZARDS = {
+    '++', '--', '+=', '-=', '*=', '/=', '%=', '&=', '|=', '^=', '<=', '>=', '==', '!=', '&&', '||',
+    '<<', '>>', '->', '::', '##', '<:', '<%', '%:', ':>', '%>', '..', '[[', ']]', '/*', '//', '*/', '.*',
+}
+
+def needs_space(left, right):
+    if not left or not right: return False
+    is_word = lambda c: c.isalnum() or c == '_'
+    if is_word(left) and is_word(right): return True
+    if (is_word(left) and right in '"\'') or (left in '"\'' and is_word(right)): return True  # L"x", "x"_sv
+    return left + right in TOKEN_HAZARDS
 
 def minify_cpp_line(line):
-    """Performs aggressive whitespace reduction on a single line of C++ code."""
-    minified = re.sub(r'\s+', ' ', line)
-    minified = re.sub(r'\s*([;{}(),<>=\[\]])\s*', r'\1', minified)
+    """Performs aggressive whitespace reduction on a single line of C++ code, outside literals."""
+    pieces = split_literals(line.strip())
+    minified = ""
+    for index, (is_literal, chunk) in enumerate(pieces):
+        if is_literal:
+            minified += chunk
+            continue
+        following = pieces[index + 1][1][:1] if index + 1 < len(pieces) else ""
+        position = 0
+        for match in re.finditer(r'\s+', chunk):
+            minified += chunk[position:match.start()]
+            right = chunk[match.end():match.end() + 1] or following
+            if needs_space(minified[-1:], right): minified += " "
+            position = match.end()
+        minified += chunk[position:]
     return minified
 
+def join_minified(left, right):
+    return left + " " + right if needs_space(left[-1:], right[:1]) else left + right
+
+def minify_code_block(code_lines, minify_style, max_chars):
+    """Minifies a run of consecutive non-preprocessor lines according to the chosen style."""
+    if minify_style == "single_line":
+        joined = ""
+        for part in (minify_cpp_line(ln) for ln in code_lines): joined = join_minified(joined, part)
+        return joined
+    if minify_style == "multiline":
+        wrapped_code, current_line = "", ""
+        for part in (minify_cpp_line(ln) for ln in code_lines):
+            if not current_line: current_line = part
+            elif len(current_line) + len(part) + 1 <= max_chars: current_line = join_minified(current_line, part)
+            else:
+                wrapped_code += current_line + "\n"
+                current_line = part
+        if current_line: wrapped_code += current_line
+        return wrapped_code
+    return "\n".join(code_lines)
+
+def render_block(lines, minify_style, max_chars):
+    """Joins the preprocessed lines of one inlined header, minifying the code between directives."""
+    # Preprocessor lines stay in place so that conditional blocks
+    # (#if/#ifdef/#else/#endif) keep guarding the code they wrap.
+    blocks, code_lines = [], []
+    for ln in lines:
+        if ln.startswith('#'):
+            if code_lines: blocks.append(minify_code_block(code_lines, minify_style, max_chars))
+            code_lines = []
+            blocks.append(ln)
+        else: code_lines.append(ln)
+    if code_lines: blocks.append(minify_code_block(code_lines, minify_style, max_chars))
+    return "\n".join(blocks).strip()
+
 def process_file(input_filepath, config):
     """Reads a source file and recursively inlines marked headers."""
     source_directory = os.path.dirname(os.path.abspath(input_filepath))
     output_dir = config.get("output_dir", "build")
     minify_style = config.get("minify_style", "none")
     max_chars = config.get("multiline_max_chars", 120)
+    shake = config.get("tree_shake", False)
 
     os.makedirs(output_dir, exist_ok=True)
-    
+    cache = HeaderCache(output_dir, config.get("cache", True))
+
     base_filename = os.path.basename(input_filepath)
     output_filepath = os.path.join(output_dir, base_filename)
 
     print(f"Processing '{input_filepath}'...")
 
     try:
-        with open(input_filepath, 'r') as infile, open(output_filepath, 'w') as outfile:
-            for line in infile:
-                stripped_line = line.strip()
-
-                if stripped_line.startswith('#include "') and stripped_line.endswith('//@'):
-                    match = re.search(r'#include "([^"]+)"', stripped_line)
-                    if not match:
-                        outfile.write(line)
-                        continue
-
-                    header_name = match.group(1)
-                    header_path = os.path.join(source_directory, header_name)
-                    
-                    print(f"    -> Recursively inlining '{header_name}' with style: '{minify_style}'...")
-                    
-                    seen_files = set()
-                    flattened_content = recursively_inline(header_path, seen_files)
-                    
-                    content_no_comments = strip_comments(flattened_content)
-                    
-                    directives, code_lines = [], []
-                    for ln in content_no_comments.splitlines():
-                        stripped_ln = ln.strip()
-                        if not stripped_ln: continue
-                        if stripped_ln.startswith('#'): directives.append(stripped_ln)
-                        else: code_lines.append(stripped_ln)
-
-                    final_content = "\n".join(directives)
-                    
-                    if code_lines:
-                        if minify_style == "single_line":
-                            minified_code = [minify_cpp_line(ln) for ln in code_lines]
-                            final_content += "\n" + " ".join(minified_code)
-                        elif minify_style == "multiline":
-                            wrapped_code, current_line = "", ""
-                            minified_code = [minify_cpp_line(ln) for ln in code_lines]
-                            for part in minified_code:
-                                if not current_line: current_line = part
-                                elif len(current_line) + len(part) + 1 <= max_chars: current_line += " " + part
-                                else:
-                                    wrapped_code += current_line + "\n"
-                                    current_line = part
-                            if current_line: wrapped_code += current_line
-                            final_content += "\n" + wrapped_code
-                        else:
-                            final_content += "\n" + "\n".join(code_lines)
+        with open(input_filepath, 'r') as infile:
+            source_lines = infile.readlines()
+
+        marked = {}  # line index -> header name
+        for index, line in enumerate(source_lines):
+            stripped_line = line.strip()
+            if stripped_line.startswith('#include "') and stripped_line.endswith('//@'):
+                match = INCLUDE_RE.match(stripped_line)
+                if match: marked[index] = match.group(1)
+
+        # One graph for all marked includes: a header reached from two of them
+        # is inlined once, where it is first reached.
+        seen_files, graph = set(), {}
+        for header_name in marked.values():
+            print(f"    -> Scanning '{header_name}'...")
+            build_dependency_graph(os.path.join(source_directory, header_name), seen_files, cache, graph)
+
+        roots = set()
+        if shake:
+            user_code = "".join(line for index, line in enumerate(source_lines) if index not in marked)
+            roots = code_identifiers(strip_comments(user_code))
 
+        bundle_key = HeaderCache.key('bundle', minify_style, max_chars, shake, *marked.values(),
+                                     *(f"{path}:{entry['digest']}" for path, entry in graph.items()),
+                                     *(sorted(roots) if shake else ()))
+        rendered = cache.load('bundle', bundle_key)
+        if rendered is None:
+            emitted = set()
+            blocks = [recursively_inline(os.path.join(source_directory, header_name), emitted, graph)
+                      for header_name in marked.values()]
+            if shake:
+                blocks, removed = tree_shake(blocks, roots)
+                print(f"    -> Tree shaking removed {removed} unreachable declarations.")
+            print(f"    -> Inlining {len(graph)} headers with style: '{minify_style}'...")
+            rendered = [render_block(lines, minify_style, max_chars) for lines in blocks]
+            cache.store('bundle', bundle_key, rendered)
+        else:
+            print(f"    -> Reusing the cached bundle of {len(graph)} headers.")
+
+        with open(output_filepath, 'w') as outfile:
+            block_iter = iter(rendered)
+            for index, line in enumerate(source_lines):
+                if index in marked:
+                    header_name, final_content = marked[index], next(block_iter)
                     outfile.write(f"// --- Start of inlined file: {header_name} ---\n")
-                    outfile.write(final_content.strip() + "\n")
+                    if final_content: outfile.write(final_content + "\n")
                     outfile.write(f"// --- End of inlined file: {header_name} ---\n")
                 else:
                     outfile.write(line)
 
+        if cache.enabled:
+            print(f"    -> Cache: {cache.hits} hits, {cache.misses} misses in '{cache.directory}'")
         print(f"\n✅ Pre-processing complete. Output is in '{output_filepath}'")
 
     except FileNotFoundError:
@@ -219,7 +771,9 @@ if __name__ == "__main__":
     parser.add_argument('input_file', nargs='?', default=None, help='The C++ source file to process.')
     parser.add_argument('-c', '--config', help='Path to a JSON configuration file.')
     parser.add_argument('--install', action='store_true', help='Install the script to ~/.local/bin for easy access.')
-    
+    parser.add_argument('--no-cache', action='store_true', help='Ignore and do not write the header cache.')
+    parser.add_argument('--tree-shake', action='store_true', help='Drop declarations the source cannot reach.')
+
     args = parser.parse_args()
 
     if args.install:
@@ -227,7 +781,8 @@ if __name__ == "__main__":
     elif args.input_file:
         config_path = find_config_path(args.config)
         config = load_config(config_path)
+        if args.no_cache: config["cache"] = False
+        if args.tree_shake: config["tree_shake"] = True
         process_file(args.input_file, config)
     else:
         parser.print_help()
-